@@ -0,0 +1,43 @@
+// Counting replacements for the global allocation functions. Only the plain and
+// aligned forms are replaced: the standard library's array, nothrow and sized
+// forms all forward to these.
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include "include/alloc_tracking.h"
+
+namespace
+{
+void* allocate(std::size_t size, std::size_t alignment)
+{
+  if(size == 0) size = 1;
+  // aligned_alloc requires the size to be a multiple of the alignment.
+  auto rounded = (size + alignment - 1) & ~(alignment - 1);
+  while(true)
+  {
+    void* p = alignment <= alignof(std::max_align_t)
+                  ? std::malloc(size)
+                  : std::aligned_alloc(alignment, rounded);
+    if(p)
+    {
+      aoc::alloc::record(size);
+      return p;
+    }
+    auto handler = std::get_new_handler();
+    if(!handler) throw std::bad_alloc();
+    handler();
+  }
+}
+}  // namespace
+
+void* operator new(std::size_t size) { return allocate(size, alignof(std::max_align_t)); }
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+  return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
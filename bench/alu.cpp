@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "bench/bench_util.h"
+#include "include/alu.h"
+
+namespace
+{
+std::vector<uint64_t> make_model_numbers(size_t n)
+{
+  std::vector<uint64_t> numbers(n);
+  for(auto& number : numbers)
+  {
+    for(size_t digit = 0; digit < 14; ++digit)
+    {
+      number = number * 10 + aoc::bench::uniform(1, 9);
+    }
+  }
+  return numbers;
+}
+
+// The program decoded once into BinOps, then run on each model number.
+void BM_AluProgram(benchmark::State& state)
+{
+  auto numbers = make_model_numbers(state.range(0));
+  aoc::Program<14, 256> program(AluProgram);
+  for(auto _ : state)
+  {
+    int64_t z = 0;
+    for(auto number : numbers) z += program.Execute(number);
+    benchmark::DoNotOptimize(z);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AluProgram)->RangeMultiplier(8)->Range(64, 1 << 15);
+
+// The text interpreter behind find_max_model_number, which itself searches 9^14
+// model numbers and is not benchmarked.
+void BM_AluInterpreter(benchmark::State& state)
+{
+  auto numbers = make_model_numbers(state.range(0));
+  std::vector<std::string_view> lines;
+  for(auto program = AluProgram; !program.empty();)
+  {
+    auto end = program.find('\n');
+    lines.push_back(program.substr(0, end));
+    program = end == program.npos ? std::string_view{} : program.substr(end + 1);
+  }
+  for(auto _ : state)
+  {
+    int64_t z = 0;
+    for(auto number : numbers)
+    {
+      std::array<int, 14> digits;
+      for(size_t i = 14; i-- > 0; number /= 10) digits[i] = number % 10;
+      aoc::Memory<14> memory(digits);
+      for(auto line : lines) aoc::process_instruction(memory, line);
+      z += memory.z;
+    }
+    benchmark::DoNotOptimize(z);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AluInterpreter)->RangeMultiplier(8)->Range(64, 1 << 15);
+}  // namespace
@@ -0,0 +1,30 @@
+#include <benchmark/benchmark.h>
+
+#include "bench/bench_util.h"
+#include "include/basin.h"
+
+namespace
+{
+// Walled-off basins that each slope up from one low point, like the puzzle input;
+// uniform noise would instead flood most of the map.
+aoc::Heightmap make_heightmap(uint32_t side)
+{
+  return aoc::parse_basin(aoc::bench::generated_input(9, side));
+}
+
+void BM_HeightmapTotalRisk(benchmark::State& state)
+{
+  auto map = make_heightmap(state.range(0));
+  for(auto _ : state) benchmark::DoNotOptimize(map.total_risk());
+  state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0));
+}
+BENCHMARK(BM_HeightmapTotalRisk)->RangeMultiplier(2)->Range(32, 512);
+
+void BM_HeightmapBasinRisk(benchmark::State& state)
+{
+  auto map = make_heightmap(state.range(0));
+  for(auto _ : state) benchmark::DoNotOptimize(map.basin_risk());
+  state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0));
+}
+BENCHMARK(BM_HeightmapBasinRisk)->RangeMultiplier(2)->Range(32, 512);
+}  // namespace
@@ -0,0 +1,27 @@
+#include <benchmark/benchmark.h>
+
+#include "bench/bench_util.h"
+#include "include/beacon_scanner.h"
+
+namespace
+{
+// Each generated scanner shares 12 beacons with the one it was placed next to, so
+// the whole trench assembles; every Region::TryIntegrate attempt is in the timing.
+void BM_TrenchAssemble(benchmark::State& state)
+{
+  auto const trench =
+      aoc::parse_scanners(aoc::bench::generated_input(19, state.range(0)));
+  for(auto _ : state)
+  {
+    state.PauseTiming();
+    auto copy = trench;
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(copy.NumBeacons());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TrenchAssemble)
+    ->RangeMultiplier(2)
+    ->Range(2, 32)
+    ->Unit(benchmark::kMillisecond);
+}  // namespace
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <unistd.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "include/generators.h"
+
+namespace aoc::bench
+{
+// Every benchmark draws from the same fixed seed so runs are comparable across builds.
+inline std::mt19937_64& rng()
+{
+  static std::mt19937_64 engine(2021);
+  return engine;
+}
+
+inline uint64_t uniform(uint64_t lo, uint64_t hi)
+{
+  return std::uniform_int_distribution<uint64_t>(lo, hi)(rng());
+}
+
+// Puzzle-shaped inputs come from generators.h, seeded like the generate tool's
+// default. Each is written once per run to the temp directory, named after `name`,
+// so benches read it back through their day's own parse_* function. The files are
+// removed at exit.
+inline std::string const& input_file(
+    std::string const& name, std::function<void(std::ostream&, gen::Rng&)> const& write)
+{
+  struct Files
+  {
+    ~Files()
+    {
+      for(auto const& [_, path] : Paths) std::filesystem::remove(path);
+    }
+    std::map<std::string, std::string> Paths;
+  };
+  static Files files;
+  auto& path = files.Paths[name];
+  if(path.empty())
+  {
+    auto file = std::filesystem::temp_directory_path() /
+                ("aoc_bench_" + std::to_string(::getpid()) + "_" + name + ".txt");
+    std::ofstream os(file);
+    gen::Rng rng(2021);
+    write(os, rng);
+    if(!os.flush()) throw std::runtime_error("Failed to write " + file.string());
+    path = file.string();
+  }
+  return path;
+}
+
+// What `generate --day <day> --size <size>` writes.
+inline std::string const& generated_input(uint32_t day, size_t size)
+{
+  auto const& generator = gen::generators().at(day);
+  return input_file("day" + std::to_string(day) + "_" + std::to_string(size),
+                    [&](std::ostream& os, gen::Rng& rng) {
+                      std::ostringstream truth;
+                      generator.Generate(os, truth, rng, size);
+                    });
+}
+
+// The same text in memory, for benches of the text parsers themselves.
+inline std::string generated_text(uint32_t day, size_t size)
+{
+  std::ostringstream os, truth;
+  gen::Rng rng(2021);
+  gen::generators().at(day).Generate(os, truth, rng, size);
+  return std::move(os).str();
+}
+}  // namespace aoc::bench
@@ -0,0 +1,89 @@
+#include <benchmark/benchmark.h>
+
+#include "bench/bench_util.h"
+#include "include/bingo.h"
+
+namespace
+{
+aoc::BingoGame make_game(size_t num_cards, size_t size = aoc::BingoCard::DefaultSize)
+{
+  auto name = "bingo_" + std::to_string(num_cards) + "x" + std::to_string(size);
+  return aoc::parse_bingo(
+      aoc::bench::input_file(name, [&](std::ostream& os, aoc::gen::Rng& rng) {
+        aoc::gen::detail::bingo_cards(os, rng, num_cards, size);
+      }));
+}
+
+void BM_BingoPlayGame(benchmark::State& state)
+{
+  auto game = make_game(state.range(0));
+  for(auto _ : state)
+  {
+    state.PauseTiming();
+    auto copy = game;
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(copy.PlayGame());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BingoPlayGame)->RangeMultiplier(4)->Range(16, 1024);
+
+void BM_BingoEngine(benchmark::State& state)
+{
+  auto game = make_game(state.range(0));
+  aoc::BingoEngine engine(game.Calls(), game.Cards());
+  for(auto _ : state) benchmark::DoNotOptimize(engine.LastWinnerScore());
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BingoEngine)->RangeMultiplier(4)->Range(16, 1 << 16);
+
+// The full win order for a million cards of side 5, 8 and 10.
+void BM_BingoTimeline(benchmark::State& state)
+{
+  auto game = make_game(1 << 20, state.range(0));
+  aoc::BingoEngine engine(game.Calls(), game.Cards());
+  for(auto _ : state) benchmark::DoNotOptimize(engine.Timeline());
+  state.SetItemsProcessed(state.iterations() * engine.NumCards());
+}
+BENCHMARK(BM_BingoTimeline)->Arg(5)->Arg(8)->Arg(10)->Unit(benchmark::kMillisecond);
+
+// Cards larger than 8x8. Before timing, the engine's winners are checked against
+// the sharded scorer, and the run fails if they disagree. PlayGame is no reference
+// here: it drops every card that wins on a shared last call.
+void BM_BingoLargeCards(benchmark::State& state)
+{
+  auto game = make_game(1024, state.range(0));
+  aoc::BingoEngine engine(game.Calls(), game.Cards());
+  auto timeline = engine.Timeline();
+  auto outcome = aoc::play_sharded(game.Calls(), game.Cards(), 4);
+  auto same = [](aoc::BingoWin const& a, aoc::BingoWin const& b) {
+    return a.Card == b.Card && a.Turn == b.Turn && a.Score == b.Score;
+  };
+  if(timeline.size() != outcome.Winners || !same(timeline.front(), outcome.First) ||
+     !same(timeline.back(), outcome.Last))
+  {
+    state.SkipWithError("Engines disagree");
+    return;
+  }
+  for(auto _ : state) benchmark::DoNotOptimize(engine.Timeline());
+  state.SetItemsProcessed(state.iterations() * engine.NumCards());
+}
+BENCHMARK(BM_BingoLargeCards)->Arg(10)->Arg(16);
+
+// First and last winner of a million 5x5 cards on 1-64 threads.
+void BM_BingoSharded(benchmark::State& state)
+{
+  static auto const game = make_game(1 << 20);
+  for(auto _ : state)
+  {
+    auto outcome = aoc::play_sharded(game.Calls(), game.Cards(), state.range(0));
+    benchmark::DoNotOptimize(outcome);
+  }
+  state.SetItemsProcessed(state.iterations() * game.Cards().size());
+}
+BENCHMARK(BM_BingoSharded)
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+}  // namespace
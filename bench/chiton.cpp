@@ -0,0 +1,16 @@
+#include <benchmark/benchmark.h>
+
+#include "bench/bench_util.h"
+#include "include/chiton.h"
+
+namespace
+{
+void BM_ChitonShortestPath(benchmark::State& state)
+{
+  size_t side = state.range(0);
+  auto cave = aoc::parse_chiton(aoc::bench::generated_input(15, side));
+  for(auto _ : state) benchmark::DoNotOptimize(cave.shortest_path());
+  state.SetItemsProcessed(state.iterations() * side * side);
+}
+BENCHMARK(BM_ChitonShortestPath)->RangeMultiplier(2)->Range(16, 512);
+}  // namespace
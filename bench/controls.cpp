@@ -0,0 +1,71 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include "bench/bench_util.h"
+#include "include/controls.h"
+
+namespace
+{
+aoc::Commands make_commands(size_t n)
+{
+  return aoc::parse_commands(aoc::bench::generated_input(2, n));
+}
+
+void BM_ProcessCommands(benchmark::State& state)
+{
+  auto cmds = make_commands(state.range(0));
+  for(auto _ : state)
+  {
+    aoc::Coordinates coords;
+    for(auto const& cmd : cmds) coords.process_command(cmd);
+    benchmark::DoNotOptimize(coords);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ProcessCommands)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+
+// 64M commands split across 1-8 threads.
+void BM_FoldCommands(benchmark::State& state)
+{
+  static auto const cmds = make_commands(1 << 26);
+  for(auto _ : state) benchmark::DoNotOptimize(aoc::fold_commands(cmds, state.range(0)));
+  state.SetItemsProcessed(state.iterations() * cmds.size());
+}
+BENCHMARK(BM_FoldCommands)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+void BM_ParseCommandLines(benchmark::State& state)
+{
+  auto text = aoc::bench::generated_text(2, state.range(0));
+  aoc::Commands cmds;
+  for(auto _ : state)
+  {
+    cmds.clear();
+    for(auto line : aoc::Split(text, '\n')) cmds.push_back(aoc::parse_command(line));
+    benchmark::DoNotOptimize(cmds.data());
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+  state.counters["commands"] = benchmark::Counter(
+      state.iterations() * state.range(0), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_ParseCommandLines)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+
+void BM_DecodeCommands(benchmark::State& state)
+{
+  auto text = aoc::bench::generated_text(2, state.range(0));
+  aoc::PackedCommands cmds;
+  for(auto _ : state)
+  {
+    aoc::decode_commands(text, cmds);
+    benchmark::DoNotOptimize(cmds.data());
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+  state.counters["commands"] = benchmark::Counter(
+      state.iterations() * state.range(0), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_DecodeCommands)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+}  // namespace
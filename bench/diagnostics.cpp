@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+
+#include "bench/bench_util.h"
+#include "include/diagnostics.h"
+
+namespace
+{
+// Generated reports keep the puzzle's 12-bit rows up to 4096 of them, and the life
+// support filter never empties on them.
+void BM_DiagnosticInterpreter(benchmark::State& state)
+{
+  auto diags = aoc::parse_diagnostics(aoc::bench::generated_input(3, state.range(0)));
+  for(auto _ : state)
+  {
+    aoc::DiagnosticInterpreter interpreter(diags);
+    benchmark::DoNotOptimize(interpreter.power_consumption());
+    benchmark::DoNotOptimize(interpreter.life_support_rating());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DiagnosticInterpreter)->RangeMultiplier(4)->Range(1 << 6, 1 << 12);
+
+// The bit plane kernels are timed at fixed arities, which the generator does not
+// keep past 4096 rows, so their rows are drawn directly.
+aoc::DiagnosticReport random_report(size_t rows, size_t arity)
+{
+  aoc::DiagnosticReport report{arity, std::vector<uint64_t>(rows)};
+  for(auto& row : report.Rows) row = aoc::bench::uniform(0, (uint64_t(1) << arity) - 1);
+  return report;
+}
+
+// Transpose plus popcounts, for a runtime and a compile-time arity of 12.
+template <size_t Arity>
+void BM_BitPlanesPower(benchmark::State& state)
+{
+  auto report = random_report(state.range(0), 12);
+  for(auto _ : state)
+  {
+    aoc::BitPlanes<Arity> planes(report);
+    benchmark::DoNotOptimize(planes.power_consumption());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_BitPlanesPower, aoc::DynamicArity)
+    ->RangeMultiplier(16)
+    ->Range(1 << 10, 1 << 24);
+BENCHMARK_TEMPLATE(BM_BitPlanesPower, 12)->RangeMultiplier(16)->Range(1 << 10, 1 << 24);
+
+// Popcounts alone over already transposed 64-bit rows.
+void BM_BitPlanesCount(benchmark::State& state)
+{
+  aoc::BitPlanes<> planes(random_report(state.range(0), 64));
+  for(auto _ : state) benchmark::DoNotOptimize(planes.power_consumption());
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BitPlanesCount)->RangeMultiplier(16)->Range(1 << 10, 1 << 24);
+
+// Past 4096 rows the generator widens them to keep the report valid.
+void BM_LifeSupportSorted(benchmark::State& state)
+{
+  size_t n = state.range(0);
+  auto report = aoc::parse_diagnostic_report(aoc::bench::generated_input(3, n));
+  for(auto _ : state)
+  {
+    state.PauseTiming();
+    auto copy = report;
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(aoc::life_support_rating(copy));
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_LifeSupportSorted)->RangeMultiplier(4)->Range(1 << 6, 1 << 22);
+}  // namespace
@@ -0,0 +1,36 @@
+#include <benchmark/benchmark.h>
+
+#include "include/dirac_dice.h"
+
+namespace
+{
+// Every pair of starting squares, played to 1000 with the deterministic die.
+void BM_DiracDiceDeterministic(benchmark::State& state)
+{
+  for(auto _ : state)
+  {
+    uint64_t total = 0;
+    for(uint64_t p1 = 0; p1 < 10; ++p1)
+    {
+      for(uint64_t p2 = 0; p2 < 10; ++p2)
+      {
+        aoc::DiracDice<2, 10, 1000, aoc::DeterministicDice<100>, 3> game({p1, p2});
+        total += game.Play();
+      }
+    }
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * 100);
+}
+BENCHMARK(BM_DiracDiceDeterministic);
+
+void BM_DiracDiceQuantum(benchmark::State& state)
+{
+  for(auto _ : state)
+  {
+    aoc::QuantumDiceGame game(state.range(0), 9 - state.range(0));
+    benchmark::DoNotOptimize(game.QuantumChampionWins());
+  }
+}
+BENCHMARK(BM_DiracDiceQuantum)->DenseRange(0, 9, 3);
+}  // namespace
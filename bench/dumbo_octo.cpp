@@ -0,0 +1,20 @@
+#include <benchmark/benchmark.h>
+
+#include "bench/bench_util.h"
+#include "include/dumbo_octo.h"
+
+namespace
+{
+// The grid is fixed at 10x10, so the number of simulated steps is scaled instead.
+void BM_DumboRunSteps(benchmark::State& state)
+{
+  auto dumbo = aoc::parse_dumbo(aoc::bench::generated_input(11, aoc::Width));
+  for(auto _ : state)
+  {
+    auto copy = dumbo;
+    benchmark::DoNotOptimize(copy.run_steps(state.range(0)));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DumboRunSteps)->RangeMultiplier(4)->Range(16, 1 << 10);
+}  // namespace
@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "bench/bench_util.h"
+#include "include/flat_map.h"
+#include "include/util.h"
+
+namespace
+{
+using Offset = std::array<int32_t, 3>;
+using StdMap = std::unordered_map<Offset, size_t, aoc::array_hash>;
+using FlatMap = aoc::FlatMap<Offset, size_t, aoc::array_hash>;
+
+// Beacon-style translations; half of the probe keys are absent from the map.
+std::vector<Offset> offsets(size_t count)
+{
+  std::vector<Offset> keys(count);
+  for(auto& key : keys)
+  {
+    for(auto& c : key) c = static_cast<int32_t>(aoc::bench::uniform(0, 4000)) - 2000;
+  }
+  return keys;
+}
+
+template <typename Map>
+void BM_Lookup(benchmark::State& state)
+{
+  auto keys = offsets(state.range(0) * 2);
+  Map map;
+  for(size_t i = 0; i < keys.size(); i += 2) map[keys[i]] = i;
+
+  for(auto _ : state)
+  {
+    size_t found = 0;
+    for(auto const& key : keys) found += map.find(key) != map.end();
+    benchmark::DoNotOptimize(found);
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+  state.counters["per_lookup"] = benchmark::Counter(
+      state.iterations() * keys.size(),
+      benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+BENCHMARK_TEMPLATE(BM_Lookup, StdMap)->RangeMultiplier(16)->Range(256, 1 << 16);
+BENCHMARK_TEMPLATE(BM_Lookup, FlatMap)->RangeMultiplier(16)->Range(256, 1 << 16);
+
+// The day 19 pattern: fill a histogram, scan it, clear it, repeat.
+template <typename Map>
+void BM_Histogram(benchmark::State& state)
+{
+  auto keys = offsets(state.range(0));
+  Map map;
+  for(auto _ : state)
+  {
+    map.clear();
+    for(auto const& key : keys) map[key]++;
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK_TEMPLATE(BM_Histogram, StdMap)->RangeMultiplier(16)->Range(256, 1 << 16);
+BENCHMARK_TEMPLATE(BM_Histogram, FlatMap)->RangeMultiplier(16)->Range(256, 1 << 16);
+}  // namespace
@@ -0,0 +1,111 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "bench/bench_util.h"
+#include "include/util.h"
+
+namespace
+{
+// The XOR combiners util.h used before the mixing hash, kept for comparison.
+struct xor_pair_hash
+{
+  template <class T1, class T2>
+  std::size_t operator()(std::pair<T1, T2> const& p) const
+  {
+    return std::hash<T1>{}(p.first) ^ std::hash<T2>{}(p.second);
+  }
+};
+
+struct xor_array_hash
+{
+  template <typename T, size_t N>
+  std::size_t operator()(std::array<T, N> const& a) const
+  {
+    size_t result = 0;
+    for(auto const& v : a) result ^= std::hash<T>{}(v);
+    return result;
+  }
+};
+
+using GridPoint = std::pair<size_t, size_t>;
+using Offset = std::array<int32_t, 3>;
+
+// Chiton-style grid coordinates.
+std::vector<GridPoint> grid_points(size_t count)
+{
+  std::vector<GridPoint> keys;
+  size_t side = 1;
+  while(side * side < count) ++side;
+  for(size_t y = 0; y < side && keys.size() < count; ++y)
+  {
+    for(size_t x = 0; x < side && keys.size() < count; ++x) keys.emplace_back(x, y);
+  }
+  return keys;
+}
+
+// Beacon-style translations: differences between points in a 2000-unit cube.
+std::vector<Offset> offsets(size_t count)
+{
+  std::unordered_set<Offset, aoc::array_hash> unique;
+  auto coordinate = [] {
+    return static_cast<int32_t>(aoc::bench::uniform(0, 4000)) - 2000;
+  };
+  while(unique.size() < count) unique.insert({coordinate(), coordinate(), coordinate()});
+  return {unique.begin(), unique.end()};
+}
+
+template <typename Key, typename Hash>
+void run(benchmark::State& state, std::vector<Key> const& keys)
+{
+  std::unordered_set<Key, Hash> set(keys.begin(), keys.end());
+
+  // Keys that share a bucket with an earlier key; 0 for a perfect spread.
+  size_t colliding = 0;
+  for(size_t b = 0; b < set.bucket_count(); ++b)
+  {
+    if(set.bucket_size(b) > 1) colliding += set.bucket_size(b) - 1;
+  }
+  // Distinct keys with identical full hash values, which no table size can split.
+  std::unordered_set<size_t> hashes;
+  for(auto const& key : keys) hashes.insert(Hash{}(key));
+
+  for(auto _ : state)
+  {
+    size_t found = 0;
+    for(auto const& key : keys) found += set.count(key);
+    benchmark::DoNotOptimize(found);
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+  state.counters["bucket_collisions"] = double(colliding) / keys.size();
+  state.counters["hash_collisions"] = double(keys.size() - hashes.size()) / keys.size();
+}
+
+template <typename Hash>
+void BM_GridPointLookup(benchmark::State& state)
+{
+  run<GridPoint, Hash>(state, grid_points(state.range(0)));
+}
+BENCHMARK_TEMPLATE(BM_GridPointLookup, xor_pair_hash)
+    ->RangeMultiplier(16)
+    ->Range(256, 1 << 16);
+BENCHMARK_TEMPLATE(BM_GridPointLookup, aoc::pair_hash)
+    ->RangeMultiplier(16)
+    ->Range(256, 1 << 16);
+
+template <typename Hash>
+void BM_OffsetLookup(benchmark::State& state)
+{
+  run<Offset, Hash>(state, offsets(state.range(0)));
+}
+BENCHMARK_TEMPLATE(BM_OffsetLookup, xor_array_hash)
+    ->RangeMultiplier(16)
+    ->Range(256, 1 << 16);
+BENCHMARK_TEMPLATE(BM_OffsetLookup, aoc::array_hash)
+    ->RangeMultiplier(16)
+    ->Range(256, 1 << 16);
+}  // namespace
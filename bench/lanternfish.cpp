@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "bench/bench_util.h"
+#include "include/lanternfish.h"
+
+namespace
+{
+// A puzzle-sized school of 300 fish.
+aoc::School make_school()
+{
+  return aoc::parse_school(aoc::bench::generated_input(6, 300));
+}
+
+void BM_SchoolPassDays(benchmark::State& state)
+{
+  auto school = make_school();
+  for(auto _ : state)
+  {
+    auto copy = school;
+    benchmark::DoNotOptimize(copy.pass_days(state.range(0)));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SchoolPassDays)->RangeMultiplier(4)->Range(64, 1 << 14);
+
+void BM_SchoolFastForward(benchmark::State& state)
+{
+  auto school = make_school();
+  uint64_t days = state.range(0);
+  for(auto _ : state) benchmark::DoNotOptimize(school.population_after(days));
+}
+BENCHMARK(BM_SchoolFastForward)->RangeMultiplier(4)->Range(64, 1 << 14);
+
+void BM_SchoolFastForwardModular(benchmark::State& state)
+{
+  auto school = make_school();
+  uint64_t days = uint64_t(1) << state.range(0);
+  aoc::ModularArithmetic arith{1'000'000'007};
+  for(auto _ : state) benchmark::DoNotOptimize(school.population_after(days, arith));
+}
+BENCHMARK(BM_SchoolFastForwardModular)->DenseRange(10, 60, 25);
+
+// Independent schools with random timer distributions, advanced 256 days at once.
+// The counts are drawn directly: a batch is not something the puzzle input holds.
+void BM_SchoolBatch(benchmark::State& state)
+{
+  std::vector<aoc::TimerCounts<uint64_t>> schools(state.range(0));
+  for(auto& timers : schools)
+  {
+    for(auto& count : timers) count = aoc::bench::uniform(0, 100);
+  }
+  for(auto _ : state)
+  {
+    aoc::SchoolBatch batch(schools);
+    batch.pass_days(256);
+    benchmark::DoNotOptimize(batch.population(0));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * 256);
+}
+BENCHMARK(BM_SchoolBatch)->RangeMultiplier(8)->Range(8, 1 << 15);
+}  // namespace
@@ -0,0 +1,20 @@
+#include <benchmark/benchmark.h>
+
+#include "bench/bench_util.h"
+#include "include/navigation.h"
+
+namespace
+{
+// Half the lines corrupted and the rest incomplete, as in the puzzle input.
+void BM_NavigationScores(benchmark::State& state)
+{
+  auto lines = aoc::parse_navigation(aoc::bench::generated_input(10, state.range(0)));
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(lines.corrupted_score());
+    benchmark::DoNotOptimize(lines.autocomplete_score());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_NavigationScores)->RangeMultiplier(8)->Range(64, 1 << 15);
+}  // namespace
@@ -0,0 +1,24 @@
+#include <benchmark/benchmark.h>
+
+#include "bench/bench_util.h"
+#include "include/packet_decoder.h"
+
+namespace
+{
+// The day 16 generator's packet tree of roughly range(0) packets, before it is
+// written out as hex.
+void BM_PacketDecodeAndEvaluate(benchmark::State& state)
+{
+  std::vector<bool> bits;
+  aoc::gen::Rng rng(2021);
+  aoc::gen::detail::encode_packet(bits, rng, state.range(0));
+  for(auto _ : state)
+  {
+    aoc::Packet packet(bits);
+    benchmark::DoNotOptimize(packet.VersionSum());
+    benchmark::DoNotOptimize(packet.Value());
+  }
+  state.SetBytesProcessed(state.iterations() * bits.size() / 8);
+}
+BENCHMARK(BM_PacketDecodeAndEvaluate)->RangeMultiplier(8)->Range(8, 1 << 15);
+}  // namespace
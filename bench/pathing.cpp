@@ -0,0 +1,16 @@
+#include <benchmark/benchmark.h>
+
+#include "bench/bench_util.h"
+#include "include/pathing.h"
+
+namespace
+{
+// Path counts grow exponentially with the number of small caves, which is scaled
+// here.
+void BM_CaveUniquePaths(benchmark::State& state)
+{
+  auto system = aoc::parse_cave_system(aoc::bench::generated_input(12, state.range(0)));
+  for(auto _ : state) benchmark::DoNotOptimize(system.unique_paths().size());
+}
+BENCHMARK(BM_CaveUniquePaths)->DenseRange(2, 5);
+}  // namespace
@@ -0,0 +1,15 @@
+#include <benchmark/benchmark.h>
+
+#include "bench/bench_util.h"
+#include "include/polymers.h"
+
+namespace
+{
+void BM_PolymerScore(benchmark::State& state)
+{
+  auto formula = aoc::parse_polymer(aoc::bench::generated_input(14, 20));
+  for(auto _ : state) benchmark::DoNotOptimize(formula.score(state.range(0)));
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PolymerScore)->RangeMultiplier(2)->Range(10, 80);
+}  // namespace
@@ -0,0 +1,57 @@
+#include <benchmark/benchmark.h>
+
+#include "bench/bench_util.h"
+#include "include/reactor.h"
+
+namespace
+{
+// Cuboids with sides up to 400 in a 2400-wide cube; about three in four turn on.
+std::vector<aoc::Cuboid> make_cuboids(size_t n)
+{
+  auto axis = [] {
+    auto lo = static_cast<int32_t>(aoc::bench::uniform(0, 2000)) - 1000;
+    return std::make_pair(lo, lo + static_cast<int32_t>(aoc::bench::uniform(1, 400)));
+  };
+  std::vector<aoc::Cuboid> cuboids(n);
+  for(auto& c : cuboids)
+  {
+    c.on = aoc::bench::uniform(0, 3) != 0;
+    c.x_range = axis();
+    c.y_range = axis();
+    c.z_range = axis();
+  }
+  return cuboids;
+}
+
+// Reactor::ProcessInstructions without its per-step print: each lit cuboid minus
+// what later cuboids overlap of it.
+void BM_ReactorFutureOverlaps(benchmark::State& state)
+{
+  auto cuboids = make_cuboids(state.range(0));
+  aoc::Reactor reactor;
+  for(auto _ : state)
+  {
+    size_t on = 0;
+    for(auto it = cuboids.begin(); it != cuboids.end(); ++it)
+    {
+      if(it->on) on += it->Size() - reactor.FutureOverlaps2(it, cuboids.end());
+    }
+    benchmark::DoNotOptimize(on);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ReactorFutureOverlaps)->RangeMultiplier(4)->Range(16, 1024);
+
+void BM_ContiguousRegionMerge(benchmark::State& state)
+{
+  auto cuboids = make_cuboids(state.range(0));
+  for(auto _ : state)
+  {
+    aoc::ContiguousRegion region;
+    for(auto const& c : cuboids) region.Merge(c);
+    benchmark::DoNotOptimize(region._overlap_size);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ContiguousRegionMerge)->RangeMultiplier(4)->Range(16, 1024);
+}  // namespace
@@ -0,0 +1,34 @@
+#include <benchmark/benchmark.h>
+
+#include "bench/bench_util.h"
+#include "include/sea_cucumbers.h"
+
+namespace
+{
+void BM_CucumberCountMoves(benchmark::State& state)
+{
+  size_t side = state.range(0);
+  auto field = aoc::parse_cucumbers(aoc::bench::generated_input(25, side));
+  for(auto _ : state)
+  {
+    auto copy = field;
+    benchmark::DoNotOptimize(copy.CountMoves());
+  }
+  state.SetItemsProcessed(state.iterations() * side * side);
+}
+BENCHMARK(BM_CucumberCountMoves)->RangeMultiplier(2)->Range(16, 128);
+
+// FastField::move() prints every step, so a single east/south step is timed.
+void BM_FastFieldStep(benchmark::State& state)
+{
+  size_t side = state.range(0);
+  auto field = aoc::parse_fast_cucumbers(aoc::bench::generated_input(25, side));
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(field.move_east());
+    benchmark::DoNotOptimize(field.move_south());
+  }
+  state.SetItemsProcessed(state.iterations() * side * side);
+}
+BENCHMARK(BM_FastFieldStep)->RangeMultiplier(4)->Range(16, 1024);
+}  // namespace
@@ -0,0 +1,21 @@
+#include <benchmark/benchmark.h>
+
+#include "bench/bench_util.h"
+#include "include/segments.h"
+
+namespace
+{
+void BM_SegmentsTotal(benchmark::State& state)
+{
+  auto notes = aoc::parse_segment_notes(aoc::bench::generated_input(8, state.range(0)));
+  for(auto _ : state)
+  {
+    state.PauseTiming();
+    auto copy = notes;
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(copy.total());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SegmentsTotal)->RangeMultiplier(8)->Range(64, 1 << 15);
+}  // namespace
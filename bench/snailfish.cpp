@@ -0,0 +1,31 @@
+#include <benchmark/benchmark.h>
+
+#include "bench/bench_util.h"
+#include "include/snailfish.h"
+
+namespace
+{
+std::vector<aoc::Number> make_numbers(size_t n)
+{
+  return aoc::parse_numbers(aoc::bench::generated_input(18, n));
+}
+
+void BM_SnailfishMagnitude(benchmark::State& state)
+{
+  auto numbers = make_numbers(state.range(0));
+  for(auto _ : state) benchmark::DoNotOptimize(aoc::magnitude(numbers).first);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SnailfishMagnitude)->RangeMultiplier(4)->Range(4, 256);
+
+void BM_SnailfishGreatestBinaryMagnitude(benchmark::State& state)
+{
+  auto numbers = make_numbers(state.range(0));
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(aoc::greatest_binary_magnitude(numbers).first);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0));
+}
+BENCHMARK(BM_SnailfishGreatestBinaryMagnitude)->RangeMultiplier(2)->Range(4, 64);
+}  // namespace
@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+
+#include "bench/bench_util.h"
+#include "include/sonar.h"
+
+namespace
+{
+aoc::SonarReadings make_readings(size_t n)
+{
+  return aoc::parse_sonar_readings(aoc::bench::generated_input(1, n));
+}
+
+void BM_SonarDepthIncreases(benchmark::State& state)
+{
+  aoc::Sonar sonar(make_readings(state.range(0)));
+  for(auto _ : state) benchmark::DoNotOptimize(sonar.depth_increases());
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SonarDepthIncreases)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+
+void BM_SonarWindowedIncreases(benchmark::State& state)
+{
+  aoc::Sonar sonar(make_readings(state.range(0)));
+  for(auto _ : state) benchmark::DoNotOptimize(sonar.depth_increases(3));
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SonarWindowedIncreases)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+
+// One shared 100M-reading series (400 MB), built on first use.
+aoc::SonarReadings const& large_readings()
+{
+  static auto const readings = make_readings(100'000'000);
+  return readings;
+}
+
+void BM_SonarKernel(benchmark::State& state, aoc::detail::CountIncreases count,
+                    bool (*supported)())
+{
+  if(!supported())
+  {
+    state.SkipWithError("CPU lacks the instruction set");
+    return;
+  }
+  auto const& readings = large_readings();
+  auto n = readings.size() - 1;
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(count(readings.data(), readings.data() + 1, n));
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK_CAPTURE(BM_SonarKernel, scalar, aoc::detail::count_increases_scalar,
+                  [] { return true; })
+    ->Unit(benchmark::kMillisecond);
+#if defined(__x86_64__) || defined(__i386__)
+BENCHMARK_CAPTURE(BM_SonarKernel, sse, aoc::detail::count_increases_sse,
+                  [] { return __builtin_cpu_supports("sse4.2") != 0; })
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_SonarKernel, avx2, aoc::detail::count_increases_avx2,
+                  [] { return __builtin_cpu_supports("avx2") != 0; })
+    ->Unit(benchmark::kMillisecond);
+#endif
+
+void BM_SonarThreaded(benchmark::State& state)
+{
+  aoc::Sonar sonar(large_readings());
+  for(auto _ : state) benchmark::DoNotOptimize(sonar.depth_increases(1, state.range(0)));
+  state.SetItemsProcessed(state.iterations() * large_readings().size());
+}
+BENCHMARK(BM_SonarThreaded)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+void BM_SonarStream(benchmark::State& state)
+{
+  auto readings = make_readings(state.range(0));
+  for(auto _ : state)
+  {
+    aoc::SonarStream stream({1, 3});
+    stream.push(readings);
+    benchmark::DoNotOptimize(stream.increases(3));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SonarStream)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+
+void BM_ParseUints(benchmark::State& state)
+{
+  auto text = aoc::bench::generated_text(1, state.range(0));
+  for(auto _ : state) benchmark::DoNotOptimize(aoc::parse_uints(text));
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_ParseUints)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+}  // namespace
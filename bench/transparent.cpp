@@ -0,0 +1,17 @@
+#include <benchmark/benchmark.h>
+
+#include "bench/bench_util.h"
+#include "include/transparent.h"
+
+namespace
+{
+// The generated paper is a (2^k - 1)-wide square sized to the number of dots and
+// folded in half along each axis down to 7 wide.
+void BM_ManualApplyFolds(benchmark::State& state)
+{
+  auto manual = aoc::parse_manual(aoc::bench::generated_input(13, state.range(0)));
+  for(auto _ : state) benchmark::DoNotOptimize(manual.apply_folds().num_marks());
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ManualApplyFolds)->RangeMultiplier(16)->Range(1 << 6, 1 << 18);
+}  // namespace
@@ -0,0 +1,20 @@
+#include <benchmark/benchmark.h>
+
+#include "bench/bench_util.h"
+#include "include/trench_map.h"
+
+namespace
+{
+void BM_ImageEnhance(benchmark::State& state)
+{
+  size_t side = state.range(0);
+  auto const input = aoc::parse_image(aoc::bench::generated_input(20, side));
+  for(auto _ : state)
+  {
+    auto processor = input;
+    benchmark::DoNotOptimize(processor.Enhance(2).LitPixels());
+  }
+  state.SetItemsProcessed(state.iterations() * side * side);
+}
+BENCHMARK(BM_ImageEnhance)->RangeMultiplier(2)->Range(32, 512);
+}  // namespace
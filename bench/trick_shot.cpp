@@ -0,0 +1,18 @@
+#include <benchmark/benchmark.h>
+
+#include "include/trick_shot.h"
+
+namespace
+{
+// The puzzle's target area scaled by the argument: x in [20k, 30k], y in [-10k, -5k].
+void BM_TrickShotVelocities(benchmark::State& state)
+{
+  int k = state.range(0);
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(aoc::num_velocities({20 * k, 30 * k}, {-10 * k, -5 * k}));
+  }
+  state.SetItemsProcessed(state.iterations() * k);
+}
+BENCHMARK(BM_TrickShotVelocities)->RangeMultiplier(4)->Range(1, 64);
+}  // namespace
@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+
+#include "bench/bench_util.h"
+#include "include/vents.h"
+
+namespace
+{
+// The day 5 generator's lines on a square plane of any extent.
+std::vector<aoc::Line> make_lines(size_t num_lines, uint32_t extent)
+{
+  auto name = "vents_" + std::to_string(num_lines) + "_" + std::to_string(extent);
+  return aoc::parse_lines(
+      aoc::bench::input_file(name, [&](std::ostream& os, aoc::gen::Rng& rng) {
+        aoc::gen::detail::vent_lines(os, rng, num_lines, extent);
+      }));
+}
+
+void BM_PlaneOverlaps(benchmark::State& state)
+{
+  auto lines = make_lines(state.range(0), 1000);
+  for(auto _ : state)
+  {
+    aoc::Plane plane(lines);
+    benchmark::DoNotOptimize(plane.count_where([](uint32_t v) { return v >= 2; }));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PlaneOverlaps)->RangeMultiplier(8)->Range(64, 1 << 15);
+
+// Arguments are the number of lines and the plane extent; the dense Plane cannot
+// hold the larger extents at all.
+void BM_SweepOverlaps(benchmark::State& state)
+{
+  auto lines = make_lines(state.range(0), state.range(1));
+  for(auto _ : state) benchmark::DoNotOptimize(aoc::count_overlaps_sweep(lines));
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SweepOverlaps)
+    ->ArgsProduct({{64, 512, 4096}, {1000}})
+    ->Args({1 << 12, 1 << 20})
+    ->Args({1 << 15, 1 << 24});
+
+// Also takes the number of pool threads.
+void BM_TiledOverlaps(benchmark::State& state)
+{
+  auto lines = make_lines(state.range(0), state.range(1));
+  aoc::ThreadPool pool(state.range(2));
+  for(auto _ : state) benchmark::DoNotOptimize(aoc::count_overlaps_tiled(lines, pool));
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TiledOverlaps)
+    ->ArgsProduct({{64, 512, 4096, 1 << 15}, {1000}, {1, 4}})
+    ->UseRealTime();
+}  // namespace
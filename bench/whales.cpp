@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "bench/bench_util.h"
+#include "include/whales.h"
+
+namespace
+{
+// The day 7 generator's crabs, clustered towards zero, over any position range.
+std::string const& crab_input(size_t num_crabs, int64_t range)
+{
+  auto name = "crabs_" + std::to_string(num_crabs) + "_" + std::to_string(range);
+  return aoc::bench::input_file(name, [&](std::ostream& os, aoc::gen::Rng& rng) {
+    aoc::gen::detail::crab_positions(os, rng, num_crabs, range);
+  });
+}
+
+aoc::CrabArmy make_army(size_t num_crabs, int64_t range)
+{
+  return aoc::parse_crabs(crab_input(num_crabs, range));
+}
+
+// The exhaustive search is quadratic in the position range, so that is what is
+// scaled.
+void BM_CrabMinAlignment(benchmark::State& state)
+{
+  auto army = make_army(1000, state.range(0));
+  for(auto _ : state)
+  {
+    benchmark::DoNotOptimize(army.min_alignment_exhaustive(aoc::TriangularFuel{}));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_CrabMinAlignment)->RangeMultiplier(4)->Range(64, 1 << 12)->Complexity();
+
+// The closed forms do not depend on the range, which goes up to 2^31.
+template <typename Fuel>
+void BM_CrabClosedForm(benchmark::State& state)
+{
+  auto army = make_army(1000, int64_t(1) << state.range(0));
+  for(auto _ : state) benchmark::DoNotOptimize(army.min_alignment(Fuel{}));
+}
+BENCHMARK_TEMPLATE(BM_CrabClosedForm, aoc::LinearFuel)->DenseRange(6, 31, 25);
+BENCHMARK_TEMPLATE(BM_CrabClosedForm, aoc::TriangularFuel)->DenseRange(6, 31, 25);
+
+// Not a polynomial, so every probe of the search visits every position.
+struct CubicFuel
+{
+  uint64_t operator()(uint64_t distance) const { return distance * distance * distance; }
+};
+
+// The search probes O(log range) positions, each costing O(log n) through the
+// prefix sums for polynomial models.
+template <typename Fuel>
+void BM_CrabSearch(benchmark::State& state)
+{
+  auto army = make_army(1000, int64_t(1) << state.range(0));
+  for(auto _ : state) benchmark::DoNotOptimize(army.min_alignment_search(Fuel{}));
+}
+BENCHMARK_TEMPLATE(BM_CrabSearch, aoc::TriangularFuel)->DenseRange(6, 31, 25);
+BENCHMARK_TEMPLATE(BM_CrabSearch, aoc::QuadraticFuel)->DenseRange(6, 31, 25);
+BENCHMARK_TEMPLATE(BM_CrabSearch, CubicFuel)->Arg(12);
+
+// A million crabs over 2^range(0) positions: the narrow range takes the dense
+// counting path and the wide one the radix sort.
+std::vector<uint32_t> crab_positions(int64_t range_bits)
+{
+  aoc::InputView input(crab_input(1'000'000, (int64_t(1) << range_bits) - 1));
+  return aoc::parse_uints(input.contents());
+}
+
+// The tree histogram CrabArmy kept before, for comparison.
+void BM_CrabIngestMap(benchmark::State& state)
+{
+  auto positions = crab_positions(state.range(0));
+  for(auto _ : state)
+  {
+    std::map<uint32_t, uint32_t> histogram;
+    for(auto pos : positions) histogram[pos]++;
+    benchmark::DoNotOptimize(histogram.size());
+  }
+  state.SetItemsProcessed(state.iterations() * positions.size());
+}
+BENCHMARK(BM_CrabIngestMap)->Arg(11)->Arg(31);
+
+void BM_CrabIngest(benchmark::State& state)
+{
+  auto positions = crab_positions(state.range(0));
+  for(auto _ : state)
+  {
+    aoc::CrabArmy army(positions);
+    benchmark::DoNotOptimize(army.size());
+  }
+  state.SetItemsProcessed(state.iterations() * positions.size());
+}
+BENCHMARK(BM_CrabIngest)->Arg(11)->Arg(31);
+}  // namespace
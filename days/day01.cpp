@@ -0,0 +1 @@
+#include "include/sonar.h"
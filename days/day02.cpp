@@ -0,0 +1 @@
+#include "include/controls.h"
@@ -0,0 +1 @@
+#include "include/diagnostics.h"
@@ -0,0 +1 @@
+#include "include/bingo.h"
@@ -0,0 +1 @@
+#include "include/vents.h"
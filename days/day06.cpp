@@ -0,0 +1 @@
+#include "include/lanternfish.h"
@@ -0,0 +1 @@
+#include "include/whales.h"
@@ -0,0 +1 @@
+#include "include/segments.h"
@@ -0,0 +1 @@
+#include "include/basin.h"
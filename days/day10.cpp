@@ -0,0 +1 @@
+#include "include/navigation.h"
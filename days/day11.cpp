@@ -0,0 +1 @@
+#include "include/dumbo_octo.h"
@@ -0,0 +1 @@
+#include "include/pathing.h"
@@ -0,0 +1 @@
+#include "include/transparent.h"
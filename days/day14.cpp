@@ -0,0 +1 @@
+#include "include/polymers.h"
@@ -0,0 +1 @@
+#include "include/chiton.h"
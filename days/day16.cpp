@@ -0,0 +1 @@
+#include "include/packet_decoder.h"
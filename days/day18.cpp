@@ -0,0 +1 @@
+#include "include/snailfish.h"
@@ -0,0 +1 @@
+#include "include/beacon_scanner.h"
@@ -0,0 +1 @@
+#include "include/trench_map.h"
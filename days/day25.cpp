@@ -0,0 +1 @@
+#include "include/sea_cucumbers.h"
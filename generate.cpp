@@ -0,0 +1,114 @@
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "include/generators.h"
+
+using namespace std::literals::string_view_literals;
+
+namespace
+{
+struct Options
+{
+  std::optional<uint32_t> Day;
+  std::optional<size_t> Size;
+  std::optional<std::string> Output;
+  uint64_t Seed = 2021;
+  bool List = false;
+};
+
+void usage(std::ostream& os)
+{
+  os << "usage: generate --day N [--size S] [--seed X] [--output PATH]\n"
+     << "       generate --list" << std::endl;
+}
+
+Options parse_options(int argc, char** argv)
+{
+  Options opts;
+  for(int i = 1; i < argc; ++i)
+  {
+    std::string_view arg = argv[i];
+    auto value = [&]() -> std::string {
+      if(i + 1 >= argc) throw std::invalid_argument("Missing value for option");
+      return argv[++i];
+    };
+    if(arg == "--day"sv)
+      opts.Day = std::stoul(value());
+    else if(arg == "--size"sv)
+      opts.Size = std::stoull(value());
+    else if(arg == "--seed"sv)
+      opts.Seed = std::stoull(value());
+    else if(arg == "--output"sv)
+      opts.Output = value();
+    else if(arg == "--list"sv)
+      opts.List = true;
+    else
+      throw std::invalid_argument("Unknown option");
+  }
+  return opts;
+}
+}  // namespace
+
+// Writes the input to --output (or stdout) and any ground truth to stderr.
+int main(int argc, char** argv)
+{
+  Options opts;
+  try
+  {
+    opts = parse_options(argc, argv);
+  }
+  catch(std::exception const& e)
+  {
+    std::cerr << e.what() << std::endl;
+    usage(std::cerr);
+    return EXIT_FAILURE;
+  }
+
+  auto const& generators = aoc::gen::generators();
+  if(opts.List)
+  {
+    for(auto const& [number, gen] : generators)
+    {
+      std::cout << std::setw(2) << number << "  size = " << gen.Size << " (default "
+                << gen.DefaultSize << ")" << std::endl;
+    }
+    return EXIT_SUCCESS;
+  }
+
+  if(!opts.Day)
+  {
+    usage(std::cerr);
+    return EXIT_FAILURE;
+  }
+
+  auto it = generators.find(*opts.Day);
+  if(it == generators.end())
+  {
+    std::cerr << "Day " << *opts.Day << " has no generator" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  auto const& gen = it->second;
+  aoc::gen::Rng rng(opts.Seed);
+  std::ofstream file;
+  if(opts.Output)
+  {
+    file.open(*opts.Output);
+    if(!file)
+    {
+      std::cerr << "Failed to open " << *opts.Output << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  std::ostream& os = opts.Output ? file : std::cout;
+  gen.Generate(os, std::cerr, rng, opts.Size.value_or(gen.DefaultSize));
+  os.flush();
+  return os ? EXIT_SUCCESS : EXIT_FAILURE;
+}
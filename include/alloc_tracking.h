@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace aoc::alloc
+{
+// True when the build links alloc_hooks.cpp, which replaces the global operator
+// new/delete with counting versions (configure with -DAOC_TRACK_ALLOCATIONS=ON).
+#ifdef AOC_TRACK_ALLOCATIONS
+inline constexpr bool Enabled = true;
+#else
+inline constexpr bool Enabled = false;
+#endif
+
+struct Counters
+{
+  uint64_t Allocations = 0;
+  uint64_t Bytes = 0;
+
+  Counters operator-(Counters const& other) const
+  {
+    return {Allocations - other.Allocations, Bytes - other.Bytes};
+  }
+};
+
+// Per thread, so a phase is charged only for what its own thread allocates even
+// when several days run at once. That leaves out threads a solver starts itself
+// (sharded scans, pool workers); those only reach the process-wide totals below.
+inline thread_local constinit Counters t_counters;
+
+// Every thread's allocations. Relaxed, since only deltas over a whole phase are read.
+inline constinit std::atomic<uint64_t> g_allocations = 0;
+inline constinit std::atomic<uint64_t> g_bytes = 0;
+
+inline void record(uint64_t bytes)
+{
+  ++t_counters.Allocations;
+  t_counters.Bytes += bytes;
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  g_bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+inline Counters process_counters()
+{
+  return {g_allocations.load(std::memory_order_relaxed),
+          g_bytes.load(std::memory_order_relaxed)};
+}
+
+// Allocations made by f on the calling thread; always zero unless Enabled.
+template <typename F>
+Counters measure(F&& f)
+{
+  auto before = t_counters;
+  f();
+  return t_counters - before;
+}
+
+// Allocations made while f runs on any thread, including those it starts. Exact
+// only when nothing else is running at the same time.
+template <typename F>
+Counters measure_process(F&& f)
+{
+  auto before = process_counters();
+  f();
+  return process_counters() - before;
+}
+}  // namespace aoc::alloc
@@ -157,6 +157,7 @@ struct StaticMemory
       case Variable::Z:
         return Z;
     }
+    throw std::out_of_range("Invalid variable");
   }
 
   constexpr int Access(Value val)
@@ -317,13 +318,10 @@ constexpr int execute_alu(uint64_t input, std::string_view program = AluProgram)
   return p.Execute(input);
 }
 
-inline int64_t find_max_model_number()
+inline int64_t find_max_model_number(std::string const& path = "./inputs/24-1.txt")
 {
-  auto input = open_input("./inputs/24-1.txt");
-  std::vector<std::string> program;
-  while(std::getline(input, program.emplace_back()))
-  {
-  }
+  InputView input(path);
+  std::vector<std::string_view> program(input.lines().begin(), input.lines().end());
   std::array<int, 14> model_number{9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9};
   auto result = 1;
   while(result != 0)
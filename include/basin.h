@@ -1,72 +1,40 @@
 #pragma once
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
-#include <iostream>
-#include <map>
-#include <numeric>
-#include <optional>
-#include <set>
 #include <stdexcept>
-#include <utility>
-#include <valarray>
 #include <vector>
 
+#include "grid.h"
 #include "parse.h"
+#include "registry.h"
 
 namespace aoc
 {
-enum class Direction
-{
-  Up,
-  Down,
-  Left,
-  Right
-};
-
-using Coord = std::pair<uint32_t, uint32_t>;
-using Coords = std::vector<Coord>;
-
+// The map is padded with a border of 9s: a 9 is never part of a basin and never
+// lower than its neighbours, so every cell can look at all four neighbours.
 struct Heightmap
 {
   Heightmap(uint32_t width, uint32_t height, std::vector<uint32_t> locations)
-    : _width(width), _height(height), _size(width * height), _locations(_size)
+    : _locations(width, height, 9, 1)
   {
-    if(locations.size() != _size) throw std::out_of_range("Invalid number of locations");
-    for(auto idx = 0; idx < _size; ++idx)
+    if(locations.size() != _locations.size())
+      throw std::out_of_range("Invalid number of locations");
+    size_t idx = 0;
+    for(size_t y = 0; y < height; ++y)
     {
-      _locations[idx] = locations[idx];
+      for(auto& l : _locations.row(y)) l = locations[idx++];
     }
   }
 
-  std::map<Direction, uint32_t> neighbors(uint32_t x, uint32_t y) const
-  {
-    std::map<Direction, uint32_t> n;
-    if(x != 0) n[Direction::Left] = at(x - 1, y);
-    if(x < _width - 1) n[Direction::Right] = at(x + 1, y);
-    if(y != 0) n[Direction::Up] = at(x, y - 1);
-    if(y < _height - 1) n[Direction::Down] = at(x, y + 1);
-    return n;
-  }
-
-  std::vector<Coord> neighbors(Coord coord) const
-  {
-    auto [x, y] = coord;
-    std::vector<Coord> n;
-    if(x != 0) n.emplace_back(x - 1, y);
-    if(x < _width - 1) n.emplace_back(x + 1, y);
-    if(y != 0) n.emplace_back(x, y - 1);
-    if(y < _height - 1) n.emplace_back(x, y + 1);
-    return n;
-  }
-
   uint32_t total_risk() const
   {
     uint32_t risk = 0;
-    for(auto [x, y] : find_low_points())
+    for(auto idx : find_low_points())
     {
-      risk += at(x, y) + 1;
+      risk += _locations[idx] + 1;
     }
     return risk;
   }
@@ -79,24 +47,18 @@ struct Heightmap
   }
 
  private:
-  uint32_t at(uint32_t x, uint32_t y) const { return _locations[y * _width + x]; }
-  uint32_t at(Coord const& c) const { return at(c.first, c.second); }
-
-  Coords find_low_points() const
+  std::vector<size_t> find_low_points() const
   {
-    Coords low_points;
-    for(auto h = 0; h < _height; ++h)
-    {
-      for(auto w = 0; w < _width; ++w)
+    std::vector<size_t> low_points;
+    _locations.for_each([&](size_t, size_t, size_t idx) {
+      auto l = _locations[idx];
+      auto const& offsets = _locations.offsets4();
+      if(std::all_of(offsets.begin(), offsets.end(),
+                     [&](auto o) { return _locations[idx + o] > l; }))
       {
-        auto l = at(w, h);
-        auto n = neighbors(w, h);
-        if(std::all_of(n.begin(), n.end(), [l](auto it) { return it.second > l; }))
-        {
-          low_points.emplace_back(w, h);
-        }
+        low_points.push_back(idx);
       }
-    }
+    });
 
     return low_points;
   }
@@ -104,51 +66,59 @@ struct Heightmap
   std::vector<uint32_t> find_basins() const
   {
     std::vector<uint32_t> basins;
-    for(auto c : find_low_points())
+    Grid<uint8_t> seen(_locations.width(), _locations.height(), 0, 1);
+    for(auto idx : find_low_points())
     {
-      std::set<Coord> seen;
-      basins.push_back(basin_recurse(seen, c));
+      basins.push_back(basin_fill(seen, idx));
     }
     return basins;
   }
 
-  uint32_t basin_recurse(std::set<Coord>& seen, Coord coord) const
+  // Basins are bounded by 9s, so a low point's basin never reaches another's and
+  // one visited grid serves all of them.
+  uint32_t basin_fill(Grid<uint8_t>& seen, size_t start) const
   {
-    if(at(coord) == 9 || seen.contains(coord)) return 0;
-    seen.insert(coord);
-    auto n = neighbors(coord);
-    return std::accumulate(n.begin(), n.end(), 1, [&seen, this](auto r, auto const& c) {
-      return r + basin_recurse(seen, c);
-    });
+    uint32_t size = 0;
+    std::vector<size_t> pending{start};
+    while(!pending.empty())
+    {
+      auto idx = pending.back();
+      pending.pop_back();
+      if(_locations[idx] == 9 || seen[idx]) continue;
+      seen[idx] = 1;
+      ++size;
+      for(auto o : _locations.offsets4()) pending.push_back(idx + o);
+    }
+    return size;
   }
 
  private:
-  uint32_t _width;
-  uint32_t _height;
-  uint32_t _size;
-  std::valarray<uint32_t> _locations;
+  Grid<uint8_t> _locations;
 };
 
-inline Heightmap parse_basin()
+inline Heightmap parse_basin(std::string const& path = "./inputs/9-1.txt")
 {
-  auto input = open_input("./inputs/9-1.txt");
-  std::string line;
+  InputView input(path);
   uint32_t width = 0;
   uint32_t height = 0;
   std::vector<uint32_t> locations;
-  while(std::getline(input, line))
+  locations.reserve(input.size());
+  for(auto line : input.lines())
   {
     ++height;
-    std::istringstream iss(line);
-    char l;
-    bool should_calc_width = width == 0;
-    while(iss.get(l))
+    if(width == 0) width = line.size();
+    for(auto l : line)
     {
-      if(should_calc_width) ++width;
       locations.push_back(l - 48);
     }
   }
 
   return Heightmap(width, height, std::move(locations));
 }
+
+AOC_REGISTER_DAY(
+    9, "Smoke Basin", "./inputs/9-1.txt",
+    [](std::string const& path) { return parse_basin(path); },
+    [](Heightmap& map) { return map.total_risk(); },
+    [](Heightmap& map) { return map.basin_risk(); });
 }  // namespace aoc
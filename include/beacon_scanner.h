@@ -11,10 +11,11 @@
 #include <stdexcept>
 #include <string>
 #include <tuple>
-#include <unordered_set>
 #include <vector>
 
+#include "flat_map.h"
 #include "parse.h"
+#include "registry.h"
 #include "util.h"
 
 namespace aoc
@@ -24,7 +25,7 @@ struct Point
   constexpr Point(int32_t x, int32_t y, int32_t z) : _point{x, y, z} {}
   explicit constexpr Point(std::array<int32_t, 3> point) : _point{std::move(point)} {}
 
-  std::array<int32_t, 3> const& Coordinates() const { return _point; }
+  constexpr std::array<int32_t, 3> const& Coordinates() const { return _point; }
   constexpr int32_t X() const { return _point[0]; }
   constexpr int32_t Y() const { return _point[1]; }
   constexpr int32_t Z() const { return _point[2]; }
@@ -121,7 +122,7 @@ struct point_hash
   size_t operator()(Point const& p) const { return array_hash()(p.Coordinates()); }
 };
 
-using PointSet = std::unordered_set<Point, point_hash>;
+using PointSet = FlatSet<Point, point_hash>;
 
 struct Scanner
 {
@@ -144,19 +145,20 @@ struct Region
   {
     for(auto const& matrix : AllTranslations)
     {
-      std::unordered_map<std::array<int32_t, 3>, size_t, array_hash> translations;
+      _translations.clear();
+      _translations.reserve(scanner.Points().size() * _beacons.size());
       for(auto const& point : scanner.Points())
       {
         auto translated_point = matrix.Translate(point);
         for(auto const& in_region : _beacons)
         {
-          translations[translated_point.TranslateTo(in_region)]++;
+          _translations[translated_point.TranslateTo(in_region)]++;
         }
       }
 
-      auto it = std::find_if(translations.begin(), translations.end(),
+      auto it = std::find_if(_translations.begin(), _translations.end(),
                              [](auto const& kvp) { return kvp.second >= 12; });
-      if(it != translations.end())
+      if(it != _translations.end())
       {
         auto const& translation = it->first;
         _scanners.emplace(matrix.Translate({0, 0, 0}).Coordinates() + translation);
@@ -187,6 +189,9 @@ struct Region
  private:
   PointSet _beacons;
   PointSet _scanners{{0, 0, 0}};
+  // Offset histogram reused across every matrix and scanner; clear() keeps its
+  // slots, so it stops allocating once it reaches the largest region.
+  FlatMap<std::array<int32_t, 3>, size_t, array_hash> _translations;
 };
 
 struct Trench
@@ -266,12 +271,11 @@ struct Trench
   std::vector<Scanner> _scanners;
 };
 
-inline Trench parse_scanners()
+inline Trench parse_scanners(std::string const& path = "inputs/19-1.txt")
 {
-  auto input = open_input("inputs/19-1.txt");
-  std::string line, x, y, z;
+  InputView input(path);
   Trench trench;
-  while(std::getline(input, line))
+  for(auto line : input.lines())
   {
     if(line.starts_with("---"))
       trench.AddScanner();
@@ -279,17 +283,21 @@ inline Trench parse_scanners()
       continue;
     else
     {
-      std::istringstream iss(line);
+      Cursor cursor(line);
       auto& scanner = trench.CurrentScanner();
-      if(!iss.getline(x.data(), 6, ',') || !iss.getline(y.data(), 6, ',') ||
-         !iss.getline(z.data(), 6))
-      {
-        throw std::out_of_range("Failed to parse point");
-      }
-      scanner.AddPoint(std::atoi(x.c_str()), std::atoi(y.c_str()), std::atoi(z.c_str()));
+      auto x = to_number<int32_t>(cursor.until(','));
+      auto y = to_number<int32_t>(cursor.until(','));
+      auto z = to_number<int32_t>(cursor.rest());
+      scanner.AddPoint(x, y, z);
     }
   }
 
   return trench;
 }
+
+AOC_REGISTER_DAY(
+    19, "Beacon Scanner", "inputs/19-1.txt",
+    [](std::string const& path) { return parse_scanners(path); },
+    [](Trench& trench) { return trench.NumBeacons(); },
+    [](Trench& trench) { return trench.ManhattanDistance(); });
 }  // namespace aoc
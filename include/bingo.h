@@ -1,40 +1,52 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <fstream>
 #include <iostream>
+#include <optional>
 #include <set>
 #include <sstream>
 #include <stdexcept>
+#include <thread>
 #include <valarray>
 #include <vector>
 
+#include "flat_map.h"
+#include "parse.h"
+#include "registry.h"
+
 namespace aoc
 {
 using Moves = std::vector<uint32_t>;
 using CardMatrix = std::valarray<uint32_t>;
 
+// A square card of any side; the puzzle's cards are 5x5.
 class BingoCard
 {
  public:
-  static constexpr size_t CardSize = 5;
-  static constexpr size_t CardLength = CardSize * CardSize;
+  static constexpr size_t DefaultSize = 5;
+
+  explicit BingoCard(size_t size = DefaultSize) : _size(size), _numbers(size * size) {}
+
+  size_t Size() const { return _size; }
+  size_t Length() const { return _numbers.size(); }
 
   [[nodiscard]] std::optional<uint32_t> CheckWin(std::set<uint32_t> const& moves,
                                                  uint32_t mostRecentMove) const
   {
-    std::valarray<uint32_t> contains(CardSize * CardSize);
-    for(auto i = 0; i < CardLength; ++i)
+    std::valarray<uint32_t> contains(Length());
+    for(auto i = 0; i < Length(); ++i)
     {
       contains[i] = moves.contains(_numbers[i]);
     }
-    for(auto i = 0; i < CardSize; ++i)
+    for(auto i = 0; i < _size; ++i)
     {
-      std::valarray<uint32_t> row = contains[std::slice(CardSize * i, CardSize, 1)];
-      std::valarray<uint32_t> col = contains[std::slice(i, CardSize, CardSize)];
-      if(row.sum() == CardSize || col.sum() == CardSize)
+      std::valarray<uint32_t> row = contains[std::slice(_size * i, _size, 1)];
+      std::valarray<uint32_t> col = contains[std::slice(i, _size, _size)];
+      if(row.sum() == _size || col.sum() == _size)
       {
         return {Score(moves, mostRecentMove)};
       }
@@ -43,6 +55,8 @@ class BingoCard
     return std::nullopt;
   }
 
+  uint32_t Number(size_t cell) const { return _numbers[cell]; }
+
  private:
   uint32_t Score(std::set<uint32_t> const& moves, uint32_t mostRecentMove) const
   {
@@ -60,20 +74,22 @@ class BingoCard
 
  private:
   friend std::istream& operator>>(std::istream&, BingoCard&);
+  friend Cursor& operator>>(Cursor&, BingoCard&);
 
-  CardMatrix _numbers = CardMatrix(CardSize * CardSize);
+  size_t _size;
+  CardMatrix _numbers;
 };
 
 inline std::istream& operator>>(std::istream& is, BingoCard& card)
 {
-  for(auto i = 0; i < BingoCard::CardSize; ++i)
+  for(auto i = 0; i < card.Size(); ++i)
   {
     std::string line;
     if(!std::getline(is, line)) throw std::out_of_range("Failed to get line");
     std::istringstream iss(line);
-    for(auto j = 0; j < BingoCard::CardSize; ++j)
+    for(auto j = 0; j < card.Size(); ++j)
     {
-      iss >> card._numbers[j + i * BingoCard::CardSize];
+      iss >> card._numbers[j + i * card.Size()];
       iss >> std::ws;
     }
   }
@@ -81,6 +97,16 @@ inline std::istream& operator>>(std::istream& is, BingoCard& card)
   return is;
 }
 
+inline Cursor& operator>>(Cursor& cursor, BingoCard& card)
+{
+  for(auto i = 0; i < card.Length(); ++i)
+  {
+    card._numbers[i] = cursor.number<uint32_t>();
+  }
+
+  return cursor;
+}
+
 class BingoGame
 {
  public:
@@ -89,6 +115,9 @@ class BingoGame
   {
   }
 
+  Moves const& Calls() const { return _moves; }
+  std::vector<BingoCard> const& Cards() const { return _cards; }
+
   uint32_t PlayGame()
   {
     std::set<uint32_t> moves;
@@ -118,28 +147,314 @@ class BingoGame
   std::vector<BingoCard> _cards;
 };
 
-inline BingoGame parse_bingo()
+struct BingoWin
+{
+  uint32_t Card;
+  // Index into the called numbers of the call that completed the card.
+  uint32_t Turn;
+  uint64_t Score;
+};
+
+namespace detail
+{
+// Dense ids for the called numbers, in order of first call, so that indexes are
+// sized by the input rather than by the largest number. Numbers that are never
+// called have no id: no cell holding one is ever marked.
+struct CallIds
+{
+  FlatMap<uint32_t, uint32_t> Ids;
+  // The id of each call, and the turn each id is first called on.
+  std::vector<uint32_t> Calls;
+  std::vector<uint32_t> FirstTurn;
+};
+
+inline CallIds index_calls(Moves const& moves)
+{
+  CallIds index;
+  index.Calls.reserve(moves.size());
+  for(uint32_t turn = 0; turn < moves.size(); ++turn)
+  {
+    auto [it, inserted] = index.Ids.try_emplace(moves[turn], index.FirstTurn.size());
+    if(inserted) index.FirstTurn.push_back(turn);
+    index.Calls.push_back(it->second);
+  }
+  return index;
+}
+}  // namespace detail
+
+// Plays every card at once. A card is a count of marked cells per row and column
+// plus the sum of its unmarked numbers, and an index from each number to the cells
+// holding it means a call only visits the cards it marks. A new mark can only
+// complete its own row or column, so those two counters are the whole win check.
+// Cards may be any size up to 65535, as long as they all match.
+class BingoEngine
+{
+ public:
+  BingoEngine(Moves moves, std::vector<BingoCard> const& cards)
+    : _moves(std::move(moves)),
+      _size(cards.empty() ? BingoCard::DefaultSize : cards.front().Size()),
+      _unmarked(cards.size(), 0)
+  {
+    if(_size == 0 || _size > UINT16_MAX) throw std::out_of_range("Unsupported card size");
+    auto cells = _size * _size;
+
+    // Counting sort of every cell by the id of its number: _first[id] is where the
+    // id's cells start.
+    auto ids = detail::index_calls(_moves);
+    _calls = std::move(ids.Calls);
+    _first_turn = std::move(ids.FirstTurn);
+    auto id_of = [&ids](uint32_t number) -> std::optional<uint32_t> {
+      auto it = ids.Ids.find(number);
+      if(it == ids.Ids.end()) return std::nullopt;
+      return it->second;
+    };
+    for(auto const& card : cards)
+    {
+      if(card.Size() != _size) throw std::out_of_range("Mixed card sizes");
+    }
+    _first.assign(_first_turn.size() + 1, 0);
+    for(auto const& card : cards)
+    {
+      for(size_t i = 0; i < cells; ++i)
+      {
+        if(auto id = id_of(card.Number(i))) ++_first[*id + 1];
+      }
+    }
+    for(size_t n = 1; n < _first.size(); ++n) _first[n] += _first[n - 1];
+
+    _cells.resize(_first.back());
+    auto next = _first;
+    for(uint32_t c = 0; c < cards.size(); ++c)
+    {
+      for(uint32_t i = 0; i < cells; ++i)
+      {
+        auto number = cards[c].Number(i);
+        _unmarked[c] += number;
+        if(auto id = id_of(number))
+        {
+          _cells[next[*id]++] = {c, static_cast<uint16_t>(i / _size),
+                                 static_cast<uint16_t>(i % _size)};
+        }
+      }
+    }
+  }
+
+  size_t NumCards() const { return _unmarked.size(); }
+
+  // Calls on_win(win) for each card as it wins, in order, until it returns false.
+  // Cards completed by the same call are reported in card order.
+  template <typename OnWin>
+  void Play(OnWin&& on_win) const
+  {
+    // Marked cells per row, then per column, of each card in turn.
+    std::vector<uint16_t> hits(2 * _size * NumCards(), 0);
+    auto row_hits = [&](uint32_t card, uint16_t row) -> uint16_t& {
+      return hits[2 * _size * card + row];
+    };
+    auto col_hits = [&](uint32_t card, uint16_t col) -> uint16_t& {
+      return hits[2 * _size * card + _size + col];
+    };
+    auto unmarked = _unmarked;
+    std::vector<uint8_t> won(NumCards(), 0);
+    for(uint32_t turn = 0; turn < _moves.size(); ++turn)
+    {
+      // A repeated call marks nothing new.
+      auto id = _calls[turn];
+      if(_first_turn[id] != turn) continue;
+      auto move = _moves[turn];
+      // Marks every cell first, so a card holding the number twice is scored with
+      // both marked.
+      for(auto n = _first[id]; n < _first[id + 1]; ++n)
+      {
+        auto [card, row, col] = _cells[n];
+        if(won[card]) continue;
+        ++row_hits(card, row);
+        ++col_hits(card, col);
+        unmarked[card] -= move;
+      }
+      for(auto n = _first[id]; n < _first[id + 1]; ++n)
+      {
+        auto [card, row, col] = _cells[n];
+        if(won[card]) continue;
+        if(row_hits(card, row) == _size || col_hits(card, col) == _size)
+        {
+          won[card] = 1;
+          if(!on_win(BingoWin{card, turn, unmarked[card] * move})) return;
+        }
+      }
+    }
+  }
+
+  // Every card that wins, in the order it wins; one pass over the calls.
+  std::vector<BingoWin> Timeline() const
+  {
+    std::vector<BingoWin> wins;
+    wins.reserve(NumCards());
+    Play([&wins, this](BingoWin const& win) {
+      wins.push_back(win);
+      return wins.size() < NumCards();
+    });
+    return wins;
+  }
+
+  uint64_t FirstWinnerScore() const
+  {
+    std::optional<uint64_t> score;
+    Play([&score](BingoWin const& win) {
+      score = win.Score;
+      return false;
+    });
+    if(!score) throw std::out_of_range("No card won");
+    return *score;
+  }
+
+  uint64_t LastWinnerScore() const
+  {
+    std::optional<uint64_t> score;
+    size_t wins = 0;
+    Play([&](BingoWin const& win) {
+      score = win.Score;
+      return ++wins < NumCards();
+    });
+    if(!score) throw std::out_of_range("No card won");
+    return *score;
+  }
+
+ private:
+  struct Cell
+  {
+    uint32_t Card;
+    uint16_t Row;
+    uint16_t Col;
+  };
+
+  Moves _moves;
+  size_t _size;
+  std::vector<uint64_t> _unmarked;
+  std::vector<uint32_t> _calls;
+  std::vector<uint32_t> _first_turn;
+  std::vector<size_t> _first;
+  std::vector<Cell> _cells;
+};
+
+// The first and last cards to win, and how many won at all. Cards that win on the
+// same call are ordered by their index.
+struct BingoOutcome
 {
-  std::ifstream input("./inputs/4-1.txt");
-  if(!input.is_open()) throw std::out_of_range("Failed to open input file");
+  BingoWin First;
+  BingoWin Last;
+  size_t Winners = 0;
+};
 
-  std::string line;
-  if(!std::getline(input, line)) throw std::out_of_range("Failed to get line");
-  std::istringstream iss(line);
-  Moves moves;
-  while(iss)
+// When every call is known up front a card can be scored on its own: it wins on
+// the turn its quickest row or column is complete, i.e. the minimum over lines of
+// the latest turn any of the line's numbers is called. `turns` maps each called
+// number to the turn it is first called on.
+inline std::optional<BingoWin> card_win(BingoCard const& card, uint32_t index,
+                                        FlatMap<uint32_t, uint32_t> const& turns,
+                                        Moves const& moves)
+{
+  auto size = card.Size();
+  // Reused across calls so that sharded play allocates once per thread.
+  static thread_local std::vector<uint32_t> turn;
+  turn.resize(card.Length());
+  for(size_t i = 0; i < card.Length(); ++i)
   {
-    iss >> moves.emplace_back();
-    iss.ignore(1, ',');
+    auto it = turns.find(card.Number(i));
+    turn[i] = it != turns.end() ? it->second : UINT32_MAX;
   }
 
+  auto win = UINT32_MAX;
+  for(size_t a = 0; a < size; ++a)
+  {
+    uint32_t row = 0, col = 0;
+    for(size_t b = 0; b < size; ++b)
+    {
+      row = std::max(row, turn[a * size + b]);
+      col = std::max(col, turn[b * size + a]);
+    }
+    win = std::min({win, row, col});
+  }
+  if(win == UINT32_MAX) return std::nullopt;
+
+  uint64_t unmarked = 0;
+  for(size_t i = 0; i < card.Length(); ++i)
+  {
+    if(turn[i] > win) unmarked += card.Number(i);
+  }
+  return BingoWin{index, win, unmarked * moves[win]};
+}
+
+// Splits the cards into one contiguous shard per thread. Shards share nothing but
+// the read-only turn index, and each keeps only its own first and last winner, so
+// merging is a comparison per shard.
+inline BingoOutcome play_sharded(Moves const& moves, std::vector<BingoCard> const& cards,
+                                 size_t threads)
+{
+  FlatMap<uint32_t, uint32_t> turns;
+  turns.reserve(moves.size());
+  for(uint32_t t = 0; t < moves.size(); ++t) turns.try_emplace(moves[t], t);
+
+  auto earlier = [](BingoWin const& a, BingoWin const& b) {
+    return a.Turn != b.Turn ? a.Turn < b.Turn : a.Card < b.Card;
+  };
+  auto merge = [&earlier](BingoOutcome& into, BingoOutcome const& from) {
+    if(from.Winners == 0) return;
+    if(into.Winners == 0 || earlier(from.First, into.First)) into.First = from.First;
+    if(into.Winners == 0 || earlier(into.Last, from.Last)) into.Last = from.Last;
+    into.Winners += from.Winners;
+  };
+
+  auto n = cards.size();
+  threads = std::clamp<size_t>(threads, 1, std::max<size_t>(n, 1));
+  std::vector<BingoOutcome> shards(threads);
+  {
+    std::vector<std::jthread> workers;
+    auto shard = [&](size_t t) {
+      for(auto c = n * t / threads; c < n * (t + 1) / threads; ++c)
+      {
+        if(auto win = card_win(cards[c], c, turns, moves))
+          merge(shards[t], BingoOutcome{*win, *win, 1});
+      }
+    };
+    for(size_t t = 1; t < threads; ++t) workers.emplace_back(shard, t);
+    shard(0);
+  }
+
+  BingoOutcome outcome;
+  for(auto const& s : shards) merge(outcome, s);
+  if(outcome.Winners == 0) throw std::out_of_range("No card won");
+  return outcome;
+}
+
+inline BingoGame parse_bingo(std::string const& path = "./inputs/4-1.txt")
+{
+  InputView input(path);
+  auto cursor = input.cursor();
+  if(cursor.done()) throw std::out_of_range("Failed to get line");
+
+  Moves moves = parse_uints(cursor.line());
+
+  // Cards are square, so the first row gives the size of all of them.
+  cursor.skip_ws();
+  auto size = BingoCard::DefaultSize;
+  if(!cursor.done()) size = parse_uints(Cursor(cursor).line()).size();
   std::vector<BingoCard> cards;
-  std::string ignore;
-  while(std::getline(input, ignore))
+  for(; !cursor.done(); cursor.skip_ws())
   {
-    input >> cards.emplace_back();
+    cursor >> cards.emplace_back(size);
   }
 
   return BingoGame(std::move(moves), std::move(cards));
 }
+
+AOC_REGISTER_DAY(
+    4, "Giant Squid", "./inputs/4-1.txt",
+    [](std::string const& path) { return parse_bingo(path); },
+    [](BingoGame& game) {
+      return BingoEngine(game.Calls(), game.Cards()).FirstWinnerScore();
+    },
+    [](BingoGame& game) {
+      return BingoEngine(game.Calls(), game.Cards()).LastWinnerScore();
+    });
 }  // namespace aoc
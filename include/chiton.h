@@ -1,168 +1,115 @@
 #pragma once
 
-#include <algorithm>
-#include <cmath>
 #include <cstddef>
-#include <cstdlib>
+#include <cstdint>
 #include <limits>
 #include <set>
+#include <stdexcept>
 #include <string>
-#include <unordered_map>
-#include <unordered_set>
+#include <string_view>
+#include <utility>
 #include <vector>
 
+#include "grid.h"
 #include "parse.h"
-#include "util.h"
+#include "registry.h"
 
 namespace aoc
 {
-using Point = std::pair<size_t, size_t>;
-using ByLocation = std::unordered_map<Point, size_t, pair_hash>;
-
-static inline std::unordered_map<Point, std::vector<Point>, pair_hash> neighbors_impl(
-    size_t width, size_t height)
-{
-  std::unordered_map<Point, std::vector<Point>, pair_hash> result;
-  for(auto x = 0; x < width; ++x)
-  {
-    for(auto y = 0; y < height; ++y)
-    {
-      Point point{x, y};
-      if(point.first > 0) result[point].emplace_back(point.first - 1, point.second);
-      if(point.first < width - 1)
-        result[point].emplace_back(point.first + 1, point.second);
-      if(point.second > 0) result[point].emplace_back(point.first, point.second - 1);
-      if(point.second < height - 1)
-        result[point].emplace_back(point.first, point.second + 1);
-    }
-  }
-
-  return result;
-}
-
-static inline std::vector<Point> const& neighbors(Point const& point, size_t width,
-                                                  size_t height)
-{
-  static auto map = neighbors_impl(width, height);
-  return map.at(point);
-}
-
 struct Location
 {
-  explicit Location(Point point) : Id(std::move(point)) {}
-
-  Point Id;
+  size_t Index;
   size_t Cost = std::numeric_limits<size_t>::max();
 
   bool operator<(Location const& other) const
   {
     if(Cost != other.Cost) return Cost < other.Cost;
-    return Id < other.Id;
+    return Index < other.Index;
   }
 };
 
 struct ChitonCave
 {
-  size_t Width;
-  size_t Height;
-  ByLocation Costs;
+  Grid<uint8_t> Costs;
 
   void print() const
   {
-    for(auto y = 0; y < Height; ++y)
-    {
-      for(auto x = 0; x < Width; ++x)
-      {
-        std::cout << Costs.at({x, y});
-      }
-      std::cout << std::endl;
-    }
+    Costs.print([](uint8_t c) { return char('0' + c); });
   }
 
   void replicate(size_t num)
   {
-    auto new_width = Width * num;
-    auto new_height = Height * num;
-    for(auto x = 0; x < new_width; ++x)
-    {
-      for(auto y = 0; y < new_height; ++y)
-      {
-        if(x < Width && y < Height) continue;
-        auto refx = x % Width;
-        auto refy = y % Height;
-        auto distance = x / Width + y / Height;
-        Costs[{x, y}] = Costs[{refx, refy}] + distance;
-        if(Costs[{x, y}] > 9) Costs[{x, y}] = Costs[{x, y}] - 9;
-      }
-    }
-    Width = new_width;
-    Height = new_height;
+    auto width = Costs.width(), height = Costs.height();
+    Grid<uint8_t> replicated(width * num, height * num, 0, 1);
+    replicated.for_each([&](size_t x, size_t y, size_t idx) {
+      auto distance = x / width + y / height;
+      auto cost = Costs(x % width, y % height) + distance;
+      replicated[idx] = (cost - 1) % 9 + 1;
+    });
+    Costs = std::move(replicated);
   }
 
+  // Dijkstra over storage indices. The border starts out visited, so neighbours
+  // are reached through fixed offsets without bounds checks.
   size_t shortest_path() const
   {
-    ByLocation tentative;
-    Location origin({0, 0});
-    origin.Cost = 0;
-    std::set<Location> unvisited{origin};
-    for(auto const& [point, _] : Costs)
+    Grid<size_t> tentative(Costs.width(), Costs.height(),
+                           std::numeric_limits<size_t>::max(), 1);
+    Grid<uint8_t> visited(Costs.width(), Costs.height(), 0, 1);
+    visited.fill_border(1);
+
+    auto origin = Costs.index(0, 0);
+    auto end = Costs.index(Costs.width() - 1, Costs.height() - 1);
+    tentative[origin] = 0;
+    std::set<Location> unvisited{{origin, 0}};
+    while(!unvisited.empty())
     {
-      unvisited.emplace(point);
-      tentative[point] = std::numeric_limits<size_t>::max();
-    }
-    tentative[origin.Id] = 0;
-    Location end({Width - 1, Height - 1});
-    while(unvisited.contains(end))
-    {
-      search(tentative, unvisited);
-    }
-
-    return tentative.at(end.Id);
-  }
-
- private:
-  void search(ByLocation& tentative, std::set<Location>& unvisited) const
-  {
-    auto pointIt = unvisited.begin();
-    auto const& ns = neighbors(pointIt->Id, Width, Height);
-    for(auto const& n : ns)
-    {
-      Location locn(n);
-      if(unvisited.contains(locn))
+      auto [idx, cost] = *unvisited.begin();
+      unvisited.erase(unvisited.begin());
+      if(idx == end) return cost;
+      visited[idx] = 1;
+      for(auto o : Costs.offsets4())
       {
-        auto prev = tentative.at(n);
-        auto curr = tentative.at(pointIt->Id) + Costs.at(n);
-        if(curr < prev)
+        auto n = idx + o;
+        if(visited[n]) continue;
+        auto curr = cost + Costs[n];
+        if(curr < tentative[n])
         {
+          if(tentative[n] != std::numeric_limits<size_t>::max())
+          {
+            unvisited.erase({n, tentative[n]});
+          }
           tentative[n] = curr;
-          unvisited.erase(locn);
-          locn.Cost = curr;
-          unvisited.insert(locn);
+          unvisited.insert({n, curr});
         }
       }
     }
-    unvisited.erase(pointIt);
+
+    throw std::out_of_range("No path through the cave");
   }
 };
 
-inline ChitonCave parse_chiton()
+inline ChitonCave parse_chiton(std::string const& path = "./inputs/15-1.txt")
 {
-  auto input = open_input("./inputs/15-1.txt");
-  ChitonCave cave;
-  size_t x = 0, y = 0;
-  std::string line;
-  while(std::getline(input, line))
+  InputView input(path);
+  auto lines = input.lines();
+  std::vector<std::string_view> rows(lines.begin(), lines.end());
+  auto width = rows.empty() ? 0 : rows.front().size();
+  ChitonCave cave{Grid<uint8_t>(width, rows.size(), 0, 1)};
+  for(size_t y = 0; y < rows.size(); ++y)
   {
-    x = 0;
-    for(auto c : line)
-    {
-      cave.Costs.emplace(std::make_pair(x++, y), c - '0');
-    }
-
-    ++y;
+    auto row = cave.Costs.row(y);
+    for(size_t x = 0; x < row.size(); ++x) row[x] = rows[y].at(x) - '0';
   }
-  cave.Width = x;
-  cave.Height = y;
   return cave;
 }
+
+AOC_REGISTER_DAY(
+    15, "Chiton", "./inputs/15-1.txt",
+    [](std::string const& path) { return parse_chiton(path); },
+    [](ChitonCave& cave) { return cave.shortest_path(); },
+    [](ChitonCave& cave) {
+      cave.replicate(5);
+      return cave.shortest_path();
+    });
 }  // namespace aoc
@@ -1,10 +1,18 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <vector>
 
 #include "parse.h"
+#include "registry.h"
 
 namespace aoc
 {
@@ -18,7 +26,7 @@ enum class Direction
 inline std::istream& operator>>(std::istream& is, Direction& dir)
 {
   std::string rawDir;
-  if(!std::getline(is, rawDir, ' ')) throw "Failed to read raw direction";
+  if(!std::getline(is, rawDir, ' ')) throw std::out_of_range("Failed to read direction");
 
   if(rawDir == "forward")
     dir = Direction::Forward;
@@ -27,7 +35,7 @@ inline std::istream& operator>>(std::istream& is, Direction& dir)
   else if(rawDir == "down")
     dir = Direction::Down;
   else
-    throw "Failed to parse direction";
+    throw std::out_of_range("Failed to parse direction");
 
   is >> std::ws;
   return is;
@@ -39,6 +47,100 @@ struct Command
   uint32_t magnitude;
 };
 
+// A command in one 32-bit word: the direction in the low two bits and the
+// magnitude above it, so a stream of commands is half the size of Commands.
+struct PackedCommand
+{
+  static constexpr uint32_t MaxMagnitude = UINT32_MAX >> 2;
+
+  uint32_t bits;
+
+  static PackedCommand pack(Direction direction, uint32_t magnitude)
+  {
+    return {magnitude << 2 | static_cast<uint32_t>(direction)};
+  }
+
+  Direction direction() const { return static_cast<Direction>(bits & 3); }
+  uint32_t magnitude() const { return bits >> 2; }
+};
+
+using PackedCommands = std::vector<PackedCommand>;
+
+// Decodes the whole input in one pass over its bytes: the first letter picks the
+// keyword, the whole keyword and the space after it are compared, and the
+// magnitude is accumulated digit by digit. `out` is cleared but keeps its
+// capacity, so decoding into a reused buffer does not allocate.
+inline void decode_commands(std::string_view text, PackedCommands& out)
+{
+  out.clear();
+  auto const* p = text.data();
+  auto const* end = p + text.size();
+  while(true)
+  {
+    while(p != end && is_space(*p)) ++p;
+    if(p == end) return;
+
+    Direction direction;
+    std::string_view keyword;
+    switch(*p)
+    {
+      case 'f':
+        direction = Direction::Forward;
+        keyword = "forward ";
+        break;
+      case 'u':
+        direction = Direction::Up;
+        keyword = "up ";
+        break;
+      case 'd':
+        direction = Direction::Down;
+        keyword = "down ";
+        break;
+      default:
+        throw std::out_of_range("Failed to parse direction");
+    }
+    if(size_t(end - p) < keyword.size() ||
+       std::memcmp(p, keyword.data(), keyword.size()) != 0)
+      throw std::out_of_range("Failed to parse direction");
+    p += keyword.size();
+
+    if(p == end || static_cast<unsigned char>(*p - '0') >= 10)
+      throw std::out_of_range("Failed to parse magnitude");
+    uint64_t magnitude = 0;
+    for(; p != end && static_cast<unsigned char>(*p - '0') < 10; ++p)
+    {
+      magnitude = magnitude * 10 + (*p - '0');
+      if(magnitude > PackedCommand::MaxMagnitude)
+        throw std::out_of_range("Magnitude out of range");
+    }
+    out.push_back(PackedCommand::pack(direction, magnitude));
+  }
+}
+
+inline PackedCommands decode_commands(std::string_view text)
+{
+  PackedCommands out;
+  // The shortest command, "up 1\n", is five bytes.
+  out.reserve(text.size() / 5);
+  decode_commands(text, out);
+  return out;
+}
+
+inline Direction parse_direction(std::string_view rawDir)
+{
+  if(rawDir == "forward") return Direction::Forward;
+  if(rawDir == "up") return Direction::Up;
+  if(rawDir == "down") return Direction::Down;
+  throw std::out_of_range("Failed to parse direction");
+}
+
+inline Command parse_command(std::string_view line)
+{
+  Cursor cursor(line);
+  auto direction = parse_direction(cursor.until(' '));
+  return Command{direction, cursor.number<uint32_t>()};
+}
+
 inline std::istream& operator>>(std::istream& is, Command& cmd)
 {
   is >> cmd.direction;
@@ -49,9 +151,9 @@ inline std::istream& operator>>(std::istream& is, Command& cmd)
 
 struct Coordinates
 {
-  int32_t x = 0;
-  int32_t y = 0;
-  int32_t aim = 0;
+  int64_t x = 0;
+  int64_t y = 0;
+  int64_t aim = 0;
 
   void process_command(Command const& cmd)
   {
@@ -73,16 +175,100 @@ struct Coordinates
 
 using Commands = std::vector<Command>;
 
-inline Commands parse_commands()
+inline std::pair<Direction, uint32_t> unpack(Command const& cmd)
 {
-  std::ifstream input = open_input("./inputs/2-1.txt");
+  return {cmd.direction, cmd.magnitude};
+}
+
+inline std::pair<Direction, uint32_t> unpack(PackedCommand cmd)
+{
+  return {cmd.direction(), cmd.magnitude()};
+}
+
+// The net effect of a run of commands on any starting position. Forward moves add
+// the current aim times their magnitude to y, so a run starting at aim a ends with
+// y + dy + a * dx; the map is affine in (x, y, aim) and runs compose associatively:
+// running `first` then `second` adds second's forward total times first's aim
+// change to y. Arithmetic wraps mod 2^64, so composition is exact even where the
+// totals overflow.
+struct CommandTransform
+{
+  uint64_t dx = 0;
+  uint64_t dy = 0;
+  uint64_t daim = 0;
+
+  template <typename Cmd>
+  static CommandTransform of(std::span<Cmd const> cmds)
+  {
+    CommandTransform t;
+    for(auto const& cmd : cmds)
+    {
+      auto [direction, magnitude] = unpack(cmd);
+      uint64_t m = magnitude;
+      uint64_t forward = direction == Direction::Forward;
+      uint64_t down = direction == Direction::Down;
+      uint64_t up = direction == Direction::Up;
+      t.dx += forward * m;
+      t.dy += forward * t.daim * m;
+      t.daim += (down - up) * m;
+    }
+    return t;
+  }
+
+  CommandTransform then(CommandTransform const& second) const
+  {
+    return {dx + second.dx, dy + second.dy + daim * second.dx, daim + second.daim};
+  }
+
+  Coordinates apply(Coordinates const& c) const
+  {
+    uint64_t x = c.x, y = c.y, aim = c.aim;
+    return {static_cast<int64_t>(x + dx), static_cast<int64_t>(y + dy + aim * dx),
+            static_cast<int64_t>(aim + daim)};
+  }
+};
+
+// Folds the commands in contiguous chunks, one per thread, then composes the
+// chunk transforms in order. Matches the sequential process_command fold.
+template <typename Cmd>
+Coordinates fold_commands(std::span<Cmd const> cmds, size_t threads = 1)
+{
+  // Below this many commands per thread, starting the thread costs more than the
+  // work it takes over.
+  constexpr size_t MinChunk = 1 << 16;
+  auto n = cmds.size();
+  threads = std::clamp<size_t>(threads, 1, std::max<size_t>(n / MinChunk, 1));
+
+  std::vector<CommandTransform> chunks(threads);
+  {
+    std::vector<std::jthread> workers;
+    auto chunk = [&](size_t t) {
+      auto first = n * t / threads, last = n * (t + 1) / threads;
+      chunks[t] = CommandTransform::of<Cmd>(cmds.subspan(first, last - first));
+    };
+    for(size_t t = 1; t < threads; ++t) workers.emplace_back(chunk, t);
+    chunk(0);
+  }
+
+  CommandTransform total;
+  for(auto const& t : chunks) total = total.then(t);
+  return total.apply({});
+}
+
+template <typename Cmd>
+Coordinates fold_commands(std::vector<Cmd> const& cmds, size_t threads = 1)
+{
+  return fold_commands(std::span<Cmd const>(cmds), threads);
+}
+
+inline Commands parse_commands(std::string const& path = "./inputs/2-1.txt")
+{
+  InputView input(path);
 
   Commands commands;
-  std::string line;
-  while(std::getline(input, line))
+  for(auto line : input.lines())
   {
-    std::istringstream iss(line);
-    iss >> commands.emplace_back();
+    commands.push_back(parse_command(line));
   }
 
   return commands;
@@ -100,4 +286,17 @@ inline int run_commands()
 
   return coords.x * coords.y;
 }
+
+// Part 1's depth is exactly part 2's aim, so one fold answers both.
+AOC_REGISTER_DAY(
+    2, "Dive!", "./inputs/2-1.txt",
+    [](std::string const& path) { return decode_commands(InputView(path).contents()); },
+    [](PackedCommands& cmds) {
+      auto coords = fold_commands(cmds);
+      return coords.x * coords.aim;
+    },
+    [](PackedCommands& cmds) {
+      auto coords = fold_commands(cmds);
+      return coords.x * coords.y;
+    });
 }  // namespace aoc
@@ -1,17 +1,28 @@
 #pragma once
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <bitset>
 #include <cstddef>
 #include <cstdint>
 #include <exception>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <span>
 #include <sstream>
 #include <stdexcept>
+#include <string_view>
 #include <vector>
 
+#include "parse.h"
+#include "registry.h"
+
 namespace aoc
 {
 constexpr size_t DiagnosticArity = 12;
@@ -104,19 +115,220 @@ class DiagnosticInterpreter
   uint32_t _scrubberRating;
 };
 
-inline Diagnostics parse_diagnostics()
+inline Diagnostics parse_diagnostics(std::string const& path = "./inputs/3-1.txt")
 {
-  std::ifstream input("./inputs/3-1.txt");
-  if(!input.is_open()) throw std::out_of_range("Failed to open input file");
+  InputView input(path);
 
   Diagnostics diags;
-  std::string line;
-  while(std::getline(input, line))
+  for(auto line : input.lines())
   {
-    std::istringstream iss(line);
-    iss >> diags.emplace_back();
+    diags.emplace_back(line.data(), std::min(line.size(), DiagnosticArity));
   }
 
   return diags;
 }
+
+// A report of any width up to 64 bits, each row stored as an integer whose most
+// significant bit is the row's first character.
+struct DiagnosticReport
+{
+  static constexpr size_t MaxArity = 64;
+
+  size_t Arity = 0;
+  std::vector<uint64_t> Rows;
+
+  static DiagnosticReport from_text(std::string_view text)
+  {
+    DiagnosticReport report;
+    for(auto line : Split(text, '\n'))
+    {
+      line = trim(line);
+      if(line.empty()) continue;
+      if(report.Rows.empty())
+      {
+        if(line.size() > MaxArity)
+          throw std::out_of_range("Diagnostic wider than 64 bits");
+        report.Arity = line.size();
+      }
+      if(line.size() != report.Arity) throw std::out_of_range("Ragged diagnostic report");
+
+      uint64_t row = 0;
+      for(auto c : line)
+      {
+        if(c != '0' && c != '1') throw std::out_of_range("Failed to parse diagnostic");
+        row = row << 1 | uint64_t(c - '0');
+      }
+      report.Rows.push_back(row);
+    }
+    return report;
+  }
+};
+
+inline DiagnosticReport parse_diagnostic_report(
+    std::string const& path = "./inputs/3-1.txt")
+{
+  InputView input(path);
+  return DiagnosticReport::from_text(input.contents());
+}
+
+namespace detail
+{
+// Transposes a 64x64 bit matrix in place by swapping ever smaller blocks (Hacker's
+// Delight 7-3). Bit c of word r moves to bit 63 - r of word 63 - c.
+inline void transpose64(uint64_t* a)
+{
+  uint64_t m = 0x00000000ffffffffull;
+  for(size_t j = 32; j != 0; j >>= 1, m ^= m << j)
+  {
+    for(size_t k = 0; k < 64; k = ((k | j) + 1) & ~j)
+    {
+      auto t = (a[k] ^ (a[k | j] >> j)) & m;
+      a[k] ^= t;
+      a[k | j] ^= t << j;
+    }
+  }
+}
+
+inline size_t count_ones_scalar(std::span<uint64_t const> words)
+{
+  size_t total = 0;
+  for(auto w : words) total += std::popcount(w);
+  return total;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+// std::popcount only becomes a single instruction when the build targets popcnt.
+__attribute__((target("popcnt"))) inline size_t count_ones_popcnt(
+    std::span<uint64_t const> words)
+{
+  size_t total = 0;
+  for(auto w : words) total += _mm_popcnt_u64(w);
+  return total;
+}
+#endif
+
+using CountOnes = size_t (*)(std::span<uint64_t const>);
+
+inline CountOnes select_count_ones()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_cpu_init();
+  if(__builtin_cpu_supports("popcnt")) return count_ones_popcnt;
+#endif
+  return count_ones_scalar;
+}
+
+inline size_t count_ones(std::span<uint64_t const> words)
+{
+  static auto const count = select_count_ones();
+  return count(words);
+}
+}  // namespace detail
+
+inline constexpr size_t DynamicArity = 0;
+
+// A report transposed into bit planes: plane b packs bit b of every row, 64 rows
+// to a word, so the number of rows with that bit set is a popcount over the
+// plane. The arity is either fixed at compile time, which gives the per-plane
+// loops constant trip counts, or taken from the report.
+template <size_t Arity = DynamicArity>
+class BitPlanes
+{
+  static_assert(Arity <= DiagnosticReport::MaxArity);
+
+ public:
+  explicit BitPlanes(DiagnosticReport const& report)
+    : _arity(Arity == DynamicArity ? report.Arity : Arity),
+      _rows(report.Rows.size()),
+      _words((_rows + 63) / 64),
+      _planes(_arity * _words, 0)
+  {
+    if(report.Arity != _arity) throw std::out_of_range("Report arity mismatch");
+
+    // A block of 64 rows, transposed, is one word of every plane. Loading the
+    // rows in reverse lands plane b in word 63 - b with row i at bit i.
+    uint64_t block[64];
+    for(size_t w = 0; w < _words; ++w)
+    {
+      auto first = w * 64;
+      auto count = std::min<size_t>(64, _rows - first);
+      std::fill_n(block, 64, 0);
+      for(size_t i = 0; i < count; ++i) block[63 - i] = report.Rows[first + i];
+      detail::transpose64(block);
+      for(size_t b = 0; b < arity(); ++b) _planes[b * _words + w] = block[63 - b];
+    }
+  }
+
+  size_t arity() const { return Arity == DynamicArity ? _arity : Arity; }
+  size_t rows() const { return _rows; }
+
+  std::span<uint64_t const> plane(size_t bit) const
+  {
+    return {_planes.data() + bit * _words, _words};
+  }
+
+  size_t ones(size_t bit) const { return detail::count_ones(plane(bit)); }
+
+  // Ties count as ones, as in DiagnosticInterpreter.
+  uint64_t gamma_rate() const
+  {
+    uint64_t gamma = 0;
+    for(size_t b = 0; b < arity(); ++b) gamma |= uint64_t(2 * ones(b) >= _rows) << b;
+    return gamma;
+  }
+
+  uint64_t epsilon_rate() const { return ~gamma_rate() & mask(); }
+
+  uint64_t power_consumption() const { return gamma_rate() * epsilon_rate(); }
+
+ private:
+  uint64_t mask() const
+  {
+    return arity() == 64 ? ~uint64_t(0) : (uint64_t(1) << arity()) - 1;
+  }
+
+  size_t _arity;
+  size_t _rows;
+  size_t _words;
+  std::vector<uint64_t> _planes;
+};
+
+// Sorting the rows once makes every candidate set of the life support filter a
+// contiguous range: the survivors share their leading bits, so within them the
+// next bit is 0 for a prefix and 1 for the rest, and one binary search splits
+// them. Both ratings then take O(arity log n) after the O(n log n) sort, which
+// reorders the report in place instead of copying it.
+inline uint64_t life_support_rating(DiagnosticReport& report)
+{
+  auto& rows = report.Rows;
+  std::sort(rows.begin(), rows.end());
+
+  auto rating = [&](bool most_common) {
+    auto first = rows.begin(), last = rows.end();
+    for(size_t bit = report.Arity; last - first > 1; --bit)
+    {
+      if(bit == 0) throw std::out_of_range("Duplicate diagnostics");
+      auto mask = uint64_t(1) << (bit - 1);
+      auto ones_start =
+          std::partition_point(first, last, [mask](auto row) { return !(row & mask); });
+      auto ones = last - ones_start, zeros = ones_start - first;
+      // Ties keep the ones for oxygen and the zeros for the scrubber.
+      bool keep_ones = (ones >= zeros) == most_common;
+      if(keep_ones)
+        first = ones_start;
+      else
+        last = ones_start;
+      if(first == last) throw std::out_of_range("Life support filter emptied");
+    }
+    if(first == last) throw std::out_of_range("Empty diagnostic report");
+    return *first;
+  };
+  return rating(true) * rating(false);
+}
+
+AOC_REGISTER_DAY(
+    3, "Binary Diagnostic", "./inputs/3-1.txt",
+    [](std::string const& path) { return parse_diagnostic_report(path); },
+    [](DiagnosticReport& report) { return BitPlanes<>(report).power_consumption(); },
+    [](DiagnosticReport& report) { return life_support_rating(report); });
 }  // namespace aoc
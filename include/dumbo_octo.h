@@ -1,60 +1,28 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <iostream>
-#include <map>
 #include <ostream>
 #include <stdexcept>
-#include <valarray>
-#include <vector>
 
+#include "grid.h"
 #include "parse.h"
-#include "util.h"
+#include "registry.h"
 
 namespace aoc
 {
 static constexpr size_t Width = 10;
 static constexpr size_t Height = 10;
 static constexpr size_t Size = Width * Height;
-static const std::valarray<size_t> StepMatrix(1, Size);
-
-inline std::map<std::pair<size_t, size_t>, std::vector<std::pair<size_t, size_t>>>
-all_neighbors()
-{
-  std::map<std::pair<size_t, size_t>, std::vector<std::pair<size_t, size_t>>> res;
-  for(auto x = 0; x < Width; ++x)
-  {
-    for(auto y = 0; y < Height; ++y)
-    {
-      std::pair<size_t, size_t> coord{x, y};
-      for(auto dx = -1; dx <= 1; ++dx)
-      {
-        if((dx == -1 && x == 0) || (dx == 1 && x == Width - 1)) continue;
-        for(auto dy = -1; dy <= 1; ++dy)
-        {
-          if((dy == -1 && y == 0) || (dy == 1 && y == Height - 1)) continue;
-          if(dx == 0 && dy == 0) continue;
-          res[coord].push_back({x + dx, y + dy});
-        }
-      }
-    }
-  }
-  return res;
-}
-
-static inline std::vector<std::pair<size_t, size_t>> neighbors(size_t x, size_t y)
-{
-  static auto _neighbors = all_neighbors();
-  return _neighbors.at({x, y});
-}
 
 struct Step
 {
   size_t total() const { return _total; }
 
-  bool set(size_t x, size_t y)
+  bool set(size_t idx)
   {
-    auto& f = _flashed[y * Width + x];
+    auto& f = _flashed[idx];
     if(f) return false;
     f = true;
     _total++;
@@ -63,37 +31,36 @@ struct Step
 
   bool converged() const { return total() == Size; }
 
-  void print() { print_matrix(_flashed, Width); }
+  void print() const
+  {
+    _flashed.print([](uint8_t f) { return f ? '1' : '0'; });
+  }
 
  private:
   size_t _total = 0;
-  std::valarray<bool> _flashed = std::valarray<bool>(Size);
+  Grid<uint8_t> _flashed = Grid<uint8_t>(Width, Height, 0, 1);
 };
 
+// Flashes spill energy into the one-cell border, which is never read back.
 struct DumboOctopus
 {
-  [[nodiscard]] size_t& at(size_t x, size_t y) { return _octopi[y * Width + x]; }
-  [[nodiscard]] size_t& at(std::pair<size_t, size_t> const& p)
+  [[nodiscard]] uint8_t& at(size_t x, size_t y) { return _octopi(x, y); }
+
+  void print() const
   {
-    return at(p.first, p.second);
+    _octopi.print([](uint8_t e) { return char('0' + e); });
   }
 
-  void print() const { print_matrix(_octopi, Width); }
-
   size_t run_steps(size_t steps)
   {
     size_t flashed = 0;
     for(auto i = 0; i < steps; ++i)
     {
       Step step;
-      _octopi += StepMatrix;
+      increment();
       flash(step);
       flashed += step.total();
       reset();
-
-      // step.print();
-      // std::cout << "Flashed: " << flashed << std::endl;
-      // print();
     }
     return flashed;
   }
@@ -106,62 +73,70 @@ struct DumboOctopus
     {
       step = Step();
       ++steps;
-      _octopi += StepMatrix;
+      increment();
       flash(step);
       reset();
-
-      // step.print();
-      // std::cout << "Flashed: " << flashed << std::endl;
-      // print();
     }
     return steps;
   }
 
  private:
+  void increment()
+  {
+    for(size_t y = 0; y < Height; ++y)
+    {
+      for(auto& e : _octopi.row(y)) ++e;
+    }
+  }
+
   void flash(Step& step)
   {
     auto flashed = false;
-    for(auto y = 0; y < Height; ++y)
-    {
-      for(auto x = 0; x < Width; ++x)
+    _octopi.for_each([&](size_t, size_t, size_t idx) {
+      if(_octopi[idx] > 9 && step.set(idx))
       {
-        if(at(x, y) > 9 && step.set(x, y))
-        {
-          flashed = true;
-          for(auto const& neighbor : neighbors(x, y))
-          {
-            at(neighbor) += 1;
-          }
-        }
+        flashed = true;
+        for(auto o : _octopi.offsets8()) _octopi[idx + o] += 1;
       }
-    }
+    });
     if(flashed) flash(step);
   }
 
   void reset()
   {
-    _octopi = _octopi.apply([](auto const& e) { return e > 9 ? 0 : e; });
+    for(size_t y = 0; y < Height; ++y)
+    {
+      for(auto& e : _octopi.row(y))
+      {
+        if(e > 9) e = 0;
+      }
+    }
   }
 
-  std::valarray<size_t> _octopi = std::valarray<size_t>(Size);
+  Grid<uint8_t> _octopi = Grid<uint8_t>(Width, Height, 0, 1);
 };
 
-inline DumboOctopus parse_dumbo()
+inline DumboOctopus parse_dumbo(std::string const& path = "./inputs/11-1.txt")
 {
-  auto input = open_input("./inputs/11-1.txt");
+  InputView input(path);
+  auto cursor = input.cursor();
   DumboOctopus dumbo;
-  std::string line;
   for(auto y = 0; y < Height; ++y)
   {
-    if(!std::getline(input, line))
-      throw std::out_of_range("Failed to parse required line");
+    if(cursor.done()) throw std::out_of_range("Failed to parse required line");
+    auto line = cursor.line();
     for(auto x = 0; x < Width; ++x)
     {
-      auto o = line.substr(x, 1);
-      dumbo.at(x, y) = std::atoi(o.c_str());
+      dumbo.at(x, y) = line.at(x) - '0';
     }
   }
 
   return dumbo;
 }
+
+AOC_REGISTER_DAY(
+    11, "Dumbo Octopus", "./inputs/11-1.txt",
+    [](std::string const& path) { return parse_dumbo(path); },
+    [](DumboOctopus& dumbo) { return dumbo.run_steps(100); },
+    [](DumboOctopus& dumbo) { return dumbo.run_until_convergence(); });
 }  // namespace aoc
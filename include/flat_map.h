@@ -0,0 +1,457 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "util.h"
+
+namespace aoc
+{
+namespace detail
+{
+// Control bytes: a full slot stores the low 7 bits of its hash; empty and deleted
+// slots have the top bit set, so one sign test finds every free slot.
+inline constexpr int8_t CtrlEmpty = -128;
+inline constexpr int8_t CtrlDeleted = -2;
+
+// Sixteen control bytes examined at once; each query returns a bitmask with one
+// bit per matching slot.
+struct Group
+{
+  static constexpr size_t Width = 16;
+
+  explicit Group(int8_t const* ctrl)
+  {
+#if defined(__SSE2__)
+    _ctrl = _mm_loadu_si128(reinterpret_cast<__m128i const*>(ctrl));
+#else
+    std::memcpy(_ctrl, ctrl, Width);
+#endif
+  }
+
+  uint32_t match(int8_t h2) const
+  {
+#if defined(__SSE2__)
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), _ctrl));
+#else
+    uint32_t mask = 0;
+    for(size_t i = 0; i < Width; ++i) mask |= uint32_t(_ctrl[i] == h2) << i;
+    return mask;
+#endif
+  }
+
+  uint32_t match_empty() const { return match(CtrlEmpty); }
+
+  uint32_t match_empty_or_deleted() const
+  {
+#if defined(__SSE2__)
+    return _mm_movemask_epi8(_ctrl);
+#else
+    uint32_t mask = 0;
+    for(size_t i = 0; i < Width; ++i) mask |= uint32_t(_ctrl[i] < 0) << i;
+    return mask;
+#endif
+  }
+
+ private:
+#if defined(__SSE2__)
+  __m128i _ctrl;
+#else
+  int8_t _ctrl[Width];
+#endif
+};
+
+struct MapKey
+{
+  template <typename Pair>
+  static auto const& get(Pair const& slot)
+  {
+    return slot.first;
+  }
+};
+
+struct SetKey
+{
+  template <typename Key>
+  static Key const& get(Key const& slot)
+  {
+    return slot;
+  }
+};
+
+// An open-addressing hash table in the style of Abseil's Swiss tables. Elements
+// live in one contiguous slot array next to an array of control bytes; lookups
+// probe a group of control bytes at a time and only touch slots whose 7-bit hash
+// fragment matches. The first group of control bytes is mirrored past the end so
+// a group can be loaded at any position without wrapping. clear() keeps the
+// allocation, so a table reused across iterations allocates only while growing.
+template <typename Key, typename Slot, typename KeyOf, typename Hash, typename Eq>
+class SwissTable
+{
+  static constexpr size_t Width = Group::Width;
+
+ public:
+  using key_type = Key;
+  using value_type = Slot;
+  using size_type = size_t;
+  using hasher = Hash;
+  using key_equal = Eq;
+
+  template <bool Const>
+  class Iterator
+  {
+    using Table = std::conditional_t<Const, SwissTable const, SwissTable>;
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Slot;
+    using difference_type = ptrdiff_t;
+    using pointer = std::conditional_t<Const, Slot const*, Slot*>;
+    using reference = std::conditional_t<Const, Slot const&, Slot&>;
+
+    Iterator() = default;
+    Iterator(Table* table, size_t index) : _table(table), _index(index) { skip(); }
+    operator Iterator<true>() const { return {_table, _index}; }
+
+    reference operator*() const { return _table->_slots[_index]; }
+    pointer operator->() const { return &_table->_slots[_index]; }
+
+    Iterator& operator++()
+    {
+      ++_index;
+      skip();
+      return *this;
+    }
+    Iterator operator++(int)
+    {
+      auto copy = *this;
+      ++*this;
+      return copy;
+    }
+
+    bool operator==(Iterator const& other) const { return _index == other._index; }
+
+   private:
+    friend class SwissTable;
+
+    void skip()
+    {
+      while(_index < _table->_capacity && _table->_ctrl[_index] < 0) ++_index;
+    }
+
+    Table* _table = nullptr;
+    size_t _index = 0;
+  };
+
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  SwissTable() = default;
+  SwissTable(std::initializer_list<Slot> init)
+  {
+    reserve(init.size());
+    for(auto const& slot : init) insert_slot(slot);
+  }
+  template <typename It>
+  SwissTable(It first, It last)
+  {
+    for(; first != last; ++first) insert_slot(*first);
+  }
+
+  SwissTable(SwissTable const& other)
+    : _ctrl(other._ctrl),
+      _capacity(other._capacity),
+      _size(other._size),
+      _growth_left(other._growth_left),
+      _hash(other._hash),
+      _eq(other._eq)
+  {
+    _slots = allocate(_capacity);
+    for(size_t i = 0; i < _capacity; ++i)
+    {
+      if(_ctrl[i] >= 0) std::construct_at(&_slots[i], other._slots[i]);
+    }
+  }
+
+  SwissTable(SwissTable&& other) noexcept { swap(other); }
+
+  SwissTable& operator=(SwissTable other) noexcept
+  {
+    swap(other);
+    return *this;
+  }
+
+  ~SwissTable()
+  {
+    destroy_all();
+    deallocate(_slots, _capacity);
+  }
+
+  void swap(SwissTable& other) noexcept
+  {
+    std::swap(_ctrl, other._ctrl);
+    std::swap(_slots, other._slots);
+    std::swap(_capacity, other._capacity);
+    std::swap(_size, other._size);
+    std::swap(_growth_left, other._growth_left);
+    std::swap(_hash, other._hash);
+    std::swap(_eq, other._eq);
+  }
+
+  size_t size() const { return _size; }
+  bool empty() const { return _size == 0; }
+  size_t capacity() const { return _capacity; }
+
+  iterator begin() { return {this, 0}; }
+  iterator end() { return {this, _capacity}; }
+  const_iterator begin() const { return {this, 0}; }
+  const_iterator end() const { return {this, _capacity}; }
+
+  iterator find(Key const& key) { return {this, find_index(key)}; }
+  const_iterator find(Key const& key) const { return {this, find_index(key)}; }
+  bool contains(Key const& key) const { return find_index(key) != _capacity; }
+  size_t count(Key const& key) const { return contains(key); }
+
+  size_t erase(Key const& key)
+  {
+    auto index = find_index(key);
+    if(index == _capacity) return 0;
+    std::destroy_at(&_slots[index]);
+    set_ctrl(index, CtrlDeleted);
+    --_size;
+    return 1;
+  }
+
+  // Destroys every element but keeps the allocation for reuse.
+  void clear()
+  {
+    destroy_all();
+    std::fill(_ctrl.begin(), _ctrl.end(), CtrlEmpty);
+    _size = 0;
+    _growth_left = max_load(_capacity);
+  }
+
+  void reserve(size_t count)
+  {
+    if(count <= max_load(_capacity)) return;
+    size_t capacity = Width;
+    while(max_load(capacity) < count) capacity *= 2;
+    rehash(capacity);
+  }
+
+ protected:
+  // Inserts a slot built from `args` unless `key` is already present.
+  template <typename... Args>
+  std::pair<iterator, bool> emplace_key(Key const& key, Args&&... args)
+  {
+    auto h = hash_of(key);
+    auto index = find_index(key, h);
+    if(index != _capacity) return {{this, index}, false};
+
+    if(_growth_left == 0)
+    {
+      // Mostly tombstones: rebuilding at the same size is enough.
+      auto grow = _size >= max_load(_capacity) / 2;
+      rehash(grow ? std::max(_capacity * 2, Width) : _capacity);
+    }
+    index = find_insert_index(h);
+    if(_ctrl[index] == CtrlEmpty) --_growth_left;
+    std::construct_at(&_slots[index], std::forward<Args>(args)...);
+    set_ctrl(index, h2(h));
+    ++_size;
+    return {{this, index}, true};
+  }
+
+  std::pair<iterator, bool> insert_slot(Slot const& slot)
+  {
+    return emplace_key(KeyOf::get(slot), slot);
+  }
+
+ private:
+  static size_t max_load(size_t capacity) { return capacity - capacity / 8; }
+  static size_t h1(size_t hash) { return hash >> 7; }
+  static int8_t h2(size_t hash) { return static_cast<int8_t>(hash & 0x7f); }
+
+  static Slot* allocate(size_t n)
+  {
+    return n ? std::allocator<Slot>().allocate(n) : nullptr;
+  }
+  static void deallocate(Slot* slots, size_t n)
+  {
+    if(slots) std::allocator<Slot>().deallocate(slots, n);
+  }
+
+  void destroy_all()
+  {
+    if constexpr(!std::is_trivially_destructible_v<Slot>)
+    {
+      for(size_t i = 0; i < _capacity; ++i)
+      {
+        if(_ctrl[i] >= 0) std::destroy_at(&_slots[i]);
+      }
+    }
+  }
+
+  void set_ctrl(size_t index, int8_t value)
+  {
+    _ctrl[index] = value;
+    if(index < Width) _ctrl[_capacity + index] = value;
+  }
+
+  // std::hash is the identity for integers, which would put every small key in
+  // one group; one extra multiply spreads it over both h1 and h2.
+  size_t hash_of(Key const& key) const
+  {
+    return hash::mix(_hash(key), hash::DefaultSeed);
+  }
+
+  size_t find_index(Key const& key) const { return find_index(key, hash_of(key)); }
+
+  // Triangular probing over groups visits every group once when the capacity is
+  // a power of two.
+  size_t find_index(Key const& key, size_t hash) const
+  {
+    if(_capacity == 0) return _capacity;
+    auto mask = _capacity - 1;
+    auto fragment = h2(hash);
+    for(size_t pos = h1(hash) & mask, step = 0;; step += Width, pos = (pos + step) & mask)
+    {
+      Group group(&_ctrl[pos]);
+      for(auto m = group.match(fragment); m != 0; m &= m - 1)
+      {
+        auto index = (pos + std::countr_zero(m)) & mask;
+        if(_eq(KeyOf::get(_slots[index]), key)) return index;
+      }
+      if(group.match_empty() != 0) return _capacity;
+    }
+  }
+
+  size_t find_insert_index(size_t hash) const
+  {
+    auto mask = _capacity - 1;
+    for(size_t pos = h1(hash) & mask, step = 0;; step += Width, pos = (pos + step) & mask)
+    {
+      auto m = Group(&_ctrl[pos]).match_empty_or_deleted();
+      if(m != 0) return (pos + std::countr_zero(m)) & mask;
+    }
+  }
+
+  void rehash(size_t capacity)
+  {
+    std::vector<int8_t> ctrl(capacity + Width, CtrlEmpty);
+    auto slots = allocate(capacity);
+    std::swap(ctrl, _ctrl);
+    std::swap(slots, _slots);
+    std::swap(capacity, _capacity);
+    _growth_left = max_load(_capacity) - _size;
+
+    for(size_t i = 0; i < capacity; ++i)
+    {
+      if(ctrl[i] < 0) continue;
+      auto h = hash_of(KeyOf::get(slots[i]));
+      auto index = find_insert_index(h);
+      std::construct_at(&_slots[index], std::move(slots[i]));
+      std::destroy_at(&slots[i]);
+      set_ctrl(index, h2(h));
+    }
+    deallocate(slots, capacity);
+  }
+
+  std::vector<int8_t> _ctrl;
+  Slot* _slots = nullptr;
+  size_t _capacity = 0;
+  size_t _size = 0;
+  size_t _growth_left = 0;
+  [[no_unique_address]] Hash _hash;
+  [[no_unique_address]] Eq _eq;
+};
+}  // namespace detail
+
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename Eq = std::equal_to<Key>>
+class FlatMap
+  : public detail::SwissTable<Key, std::pair<Key const, Value>, detail::MapKey, Hash, Eq>
+{
+  using Base =
+      detail::SwissTable<Key, std::pair<Key const, Value>, detail::MapKey, Hash, Eq>;
+
+ public:
+  using mapped_type = Value;
+  using Base::Base;
+
+  template <typename... Args>
+  std::pair<typename Base::iterator, bool> try_emplace(Key const& key, Args&&... args)
+  {
+    return this->emplace_key(key, std::piecewise_construct, std::forward_as_tuple(key),
+                             std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  template <typename... Args>
+  std::pair<typename Base::iterator, bool> emplace(Key const& key, Args&&... args)
+  {
+    return try_emplace(key, std::forward<Args>(args)...);
+  }
+
+  std::pair<typename Base::iterator, bool> insert(std::pair<Key const, Value> const& kv)
+  {
+    return this->insert_slot(kv);
+  }
+
+  Value& operator[](Key const& key) { return try_emplace(key).first->second; }
+
+  Value& at(Key const& key)
+  {
+    auto it = this->find(key);
+    if(it == this->end()) throw std::out_of_range("Key not found");
+    return it->second;
+  }
+  Value const& at(Key const& key) const
+  {
+    auto it = this->find(key);
+    if(it == this->end()) throw std::out_of_range("Key not found");
+    return it->second;
+  }
+};
+
+template <typename Key, typename Hash = std::hash<Key>, typename Eq = std::equal_to<Key>>
+class FlatSet : public detail::SwissTable<Key, Key, detail::SetKey, Hash, Eq>
+{
+  using Base = detail::SwissTable<Key, Key, detail::SetKey, Hash, Eq>;
+
+ public:
+  using Base::Base;
+
+  std::pair<typename Base::iterator, bool> insert(Key const& key)
+  {
+    return this->emplace_key(key, key);
+  }
+
+  std::pair<typename Base::iterator, bool> insert(Key&& key)
+  {
+    auto const& k = key;
+    return this->emplace_key(k, std::move(key));
+  }
+
+  template <typename... Args>
+  std::pair<typename Base::iterator, bool> emplace(Args&&... args)
+  {
+    return insert(Key(std::forward<Args>(args)...));
+  }
+};
+}  // namespace aoc
@@ -0,0 +1,698 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <ostream>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace aoc::gen
+{
+// Synthetic puzzle inputs of arbitrary size. Each generator writes the same text
+// format as the bundled inputs, so the output can be passed to any solver via
+// --input. Output is a pure function of the seed and the size.
+using Rng = std::mt19937_64;
+
+inline int64_t uniform(Rng& rng, int64_t lo, int64_t hi)
+{
+  return std::uniform_int_distribution<int64_t>(lo, hi)(rng);
+}
+
+inline bool chance(Rng& rng, double p) { return std::bernoulli_distribution(p)(rng); }
+
+template <typename T>
+void write_csv(std::ostream& os, std::vector<T> const& values)
+{
+  for(size_t i = 0; i < values.size(); ++i)
+  {
+    if(i != 0) os << ',';
+    os << values[i];
+  }
+  os << '\n';
+}
+
+template <typename Cell>
+void write_grid(std::ostream& os, size_t side, Cell cell)
+{
+  std::string line(side + 1, '\n');
+  for(size_t y = 0; y < side; ++y)
+  {
+    for(size_t x = 0; x < side; ++x) line[x] = cell(x, y);
+    os << line;
+  }
+}
+
+// Ground truth is written to `truth` for days whose answers are not cheap to
+// recompute independently of the solver under test.
+struct Generator
+{
+  using Write = std::function<void(std::ostream&, std::ostream& truth, Rng&, size_t)>;
+
+  std::string Size;
+  size_t DefaultSize;
+  Write Generate;
+};
+
+namespace detail
+{
+inline void sonar(std::ostream& os, std::ostream&, Rng& rng, size_t size)
+{
+  int64_t depth = 100;
+  for(size_t n = 0; n < size; ++n)
+  {
+    depth = std::max<int64_t>(1, depth + uniform(rng, -20, 40));
+    os << depth << '\n';
+  }
+}
+
+inline void controls(std::ostream& os, std::ostream&, Rng& rng, size_t size)
+{
+  static constexpr std::array<std::string_view, 3> Commands{"forward", "down", "up"};
+  std::discrete_distribution<size_t> pick{5, 3, 2};
+  for(size_t n = 0; n < size; ++n)
+  {
+    os << Commands[pick(rng)] << ' ' << uniform(rng, 1, 9) << '\n';
+  }
+}
+
+// Mirrors the life support filter: the candidate set must shrink to exactly one
+// value without ever emptying, which is what makes a diagnostic report valid.
+inline bool valid_diagnostics(std::vector<uint32_t> const& values, size_t arity)
+{
+  for(bool most_common : {true, false})
+  {
+    auto candidates = values;
+    for(size_t bit = arity; candidates.size() > 1; --bit)
+    {
+      if(bit == 0) return false;
+      auto mask = uint32_t(1) << (bit - 1);
+      auto ones = std::count_if(candidates.begin(), candidates.end(),
+                                [mask](auto v) { return v & mask; });
+      bool keep = (2 * static_cast<size_t>(ones) >= candidates.size()) == most_common;
+      std::erase_if(candidates, [mask, keep](auto v) { return bool(v & mask) != keep; });
+      if(candidates.empty()) return false;
+    }
+  }
+  return true;
+}
+
+// Rows are 12 bits wide, like the puzzle input, until there are more than 4096 of
+// them; larger reports widen the rows to twice as many values as rows.
+inline void diagnostics(std::ostream& os, std::ostream&, Rng& rng, size_t size)
+{
+  size = std::clamp<size_t>(size, 1, size_t(1) << 30);
+  size_t arity = size <= (size_t(1) << 12) ? 12 : std::bit_width(size - 1) + 1;
+  std::vector<uint32_t> all(size_t(1) << arity);
+  std::iota(all.begin(), all.end(), 0);
+  std::vector<uint32_t> values;
+  do
+  {
+    std::shuffle(all.begin(), all.end(), rng);
+    values.assign(all.begin(), all.begin() + size);
+  } while(!valid_diagnostics(values, arity));
+
+  std::string line(arity + 1, '\n');
+  for(auto v : values)
+  {
+    for(size_t bit = 0; bit < arity; ++bit)
+    {
+      line[arity - 1 - bit] = static_cast<char>('0' + ((v >> bit) & 1));
+    }
+    os << line;
+  }
+}
+
+// Cards of any side draw from four times as many numbers as they have cells, and
+// at least the puzzle's 100.
+inline void bingo_cards(std::ostream& os, Rng& rng, size_t num_cards, size_t side)
+{
+  std::vector<uint32_t> numbers(std::max<size_t>(100, 4 * side * side));
+  std::iota(numbers.begin(), numbers.end(), 0);
+  std::shuffle(numbers.begin(), numbers.end(), rng);
+  write_csv(os, numbers);
+
+  auto digits = std::to_string(numbers.size() - 1).size();
+  auto width = static_cast<int>(std::max<size_t>(2, digits));
+  char cell[16];
+  for(size_t card = 0; card < num_cards; ++card)
+  {
+    std::shuffle(numbers.begin(), numbers.end(), rng);
+    os << '\n';
+    for(size_t row = 0; row < side; ++row)
+    {
+      for(size_t col = 0; col < side; ++col)
+      {
+        std::snprintf(cell, sizeof(cell), "%*u", width, numbers[row * side + col]);
+        os << (col == 0 ? "" : " ") << cell;
+      }
+      os << '\n';
+    }
+  }
+}
+
+inline void bingo(std::ostream& os, std::ostream&, Rng& rng, size_t size)
+{
+  bingo_cards(os, rng, size, 5);
+}
+
+// Lines are horizontal, vertical or at 45 degrees on an extent x extent floor.
+inline void vent_lines(std::ostream& os, Rng& rng, size_t size, int64_t extent)
+{
+  auto last = extent - 1;
+  for(size_t n = 0; n < size; ++n)
+  {
+    int64_t x1 = uniform(rng, 0, last), y1 = uniform(rng, 0, last);
+    int64_t x2 = x1, y2 = y1;
+    switch(uniform(rng, 0, 2))
+    {
+      case 0: x2 = uniform(rng, 0, last); break;
+      case 1: y2 = uniform(rng, 0, last); break;
+      default:
+      {
+        auto dx = uniform(rng, 0, 1) ? 1 : -1;
+        auto dy = uniform(rng, 0, 1) ? 1 : -1;
+        auto room = std::min(dx > 0 ? last - x1 : x1, dy > 0 ? last - y1 : y1);
+        auto len = uniform(rng, 0, room);
+        x2 = x1 + dx * len;
+        y2 = y1 + dy * len;
+      }
+    }
+    os << x1 << ',' << y1 << " -> " << x2 << ',' << y2 << '\n';
+  }
+}
+
+// Lines stay on the puzzle's 1000x1000 floor; more lines means more overlap rather
+// than a larger plane.
+inline void vents(std::ostream& os, std::ostream&, Rng& rng, size_t size)
+{
+  vent_lines(os, rng, size, 1000);
+}
+
+inline void lanternfish(std::ostream& os, std::ostream&, Rng& rng, size_t size)
+{
+  std::vector<int64_t> timers(size);
+  for(auto& t : timers) t = uniform(rng, 1, 5);
+  write_csv(os, timers);
+}
+
+// Crab positions up to `range` cluster towards zero like the puzzle input.
+inline void crab_positions(std::ostream& os, Rng& rng, size_t size, int64_t range)
+{
+  std::vector<int64_t> positions(size);
+  for(auto& p : positions) p = uniform(rng, 0, uniform(rng, 0, range));
+  write_csv(os, positions);
+}
+
+inline void whales(std::ostream& os, std::ostream&, Rng& rng, size_t size)
+{
+  crab_positions(os, rng, size, 2000);
+}
+
+inline void segments(std::ostream& os, std::ostream&, Rng& rng, size_t size)
+{
+  static constexpr std::array<std::string_view, 10> Digits{
+      "abcefg", "cf",     "acdeg", "acdfg",   "bcdf",
+      "abdfg",  "abdefg", "acf",   "abcdefg", "abcdfg"};
+  std::string wiring = "abcdefg";
+  std::array<size_t, 10> order;
+  std::iota(order.begin(), order.end(), 0);
+  auto scramble = [&](size_t digit) {
+    std::string out;
+    for(auto c : Digits[digit]) out.push_back(wiring[c - 'a']);
+    std::shuffle(out.begin(), out.end(), rng);
+    return out;
+  };
+
+  for(size_t n = 0; n < size; ++n)
+  {
+    std::shuffle(wiring.begin(), wiring.end(), rng);
+    std::shuffle(order.begin(), order.end(), rng);
+    for(auto digit : order) os << scramble(digit) << ' ';
+    os << '|';
+    for(size_t i = 0; i < 4; ++i) os << ' ' << scramble(uniform(rng, 0, 9));
+    os << '\n';
+  }
+}
+
+// Basins are rectangles of random size walled off by 9s, each sloping up from a
+// single low point, so every low point owns exactly one basin as the puzzle
+// promises.
+inline void basin(std::ostream& os, std::ostream&, Rng& rng, size_t size)
+{
+  constexpr auto Wall = std::numeric_limits<size_t>::max();
+  struct Axis
+  {
+    std::vector<size_t> Cell;
+    std::vector<std::pair<size_t, size_t>> Extents;
+  };
+  auto partition = [&]() {
+    Axis axis{std::vector<size_t>(size, Wall), {}};
+    for(size_t begin = 0; begin < size;)
+    {
+      auto end = std::min<size_t>(size, begin + uniform(rng, 3, 12));
+      for(auto i = begin; i < end; ++i) axis.Cell[i] = axis.Extents.size();
+      axis.Extents.emplace_back(begin, end - 1);
+      begin = end + 1;
+    }
+    return axis;
+  };
+  auto xs = partition();
+  auto ys = partition();
+
+  std::vector<std::pair<size_t, size_t>> centers;
+  for(auto const& [ylo, yhi] : ys.Extents)
+  {
+    for(auto const& [xlo, xhi] : xs.Extents)
+    {
+      centers.emplace_back(uniform(rng, xlo, xhi), uniform(rng, ylo, yhi));
+    }
+  }
+
+  write_grid(os, size, [&](size_t x, size_t y) -> char {
+    if(xs.Cell[x] == Wall || ys.Cell[y] == Wall) return '9';
+    auto [cx, cy] = centers[ys.Cell[y] * xs.Extents.size() + xs.Cell[x]];
+    auto ring = std::max(x > cx ? x - cx : cx - x, y > cy ? y - cy : cy - y);
+    return '0' + std::min<size_t>(8, 2 * ring + uniform(rng, 0, 1));
+  });
+}
+
+// Half the lines are corrupted by one mismatched closer; the rest stop early.
+inline void navigation(std::ostream& os, std::ostream&, Rng& rng, size_t size)
+{
+  static constexpr std::string_view Open = "([{<", Close = ")]}>";
+  std::string line, stack;
+  for(size_t n = 0; n < size; ++n)
+  {
+    line.clear();
+    stack.clear();
+    auto length = uniform(rng, 80, 110);
+    auto corrupt_at = chance(rng, 0.5) ? uniform(rng, 1, length - 1) : length;
+    for(int64_t i = 0; i < length; ++i)
+    {
+      if(i == corrupt_at && !stack.empty())
+      {
+        auto wrong = (Close.find(stack.back()) + uniform(rng, 1, 3)) % 4;
+        line.push_back(Close[wrong]);
+        stack.clear();
+        corrupt_at = -1;
+        continue;
+      }
+      if(!stack.empty() && i + 1 < length && chance(rng, 0.45))
+      {
+        line.push_back(stack.back());
+        stack.pop_back();
+      }
+      else
+      {
+        auto kind = uniform(rng, 0, 3);
+        line.push_back(Open[kind]);
+        stack.push_back(Close[kind]);
+      }
+    }
+    os << line << '\n';
+  }
+}
+
+// Whether every octopus flashes in the same step within max_steps steps. Random
+// grids can settle into cycles that never synchronize, on which part 2 would
+// never return.
+inline bool dumbo_synchronizes(std::array<uint8_t, 100> energy, size_t max_steps)
+{
+  for(size_t step = 0; step < max_steps; ++step)
+  {
+    std::vector<size_t> pending;
+    for(size_t i = 0; i < energy.size(); ++i)
+    {
+      if(++energy[i] == 10) pending.push_back(i);
+    }
+    size_t flashed = 0;
+    while(!pending.empty())
+    {
+      auto i = pending.back();
+      pending.pop_back();
+      ++flashed;
+      size_t x = i % 10, y = i / 10;
+      for(auto ny = y - (y > 0); ny <= y + (y < 9); ++ny)
+      {
+        for(auto nx = x - (x > 0); nx <= x + (x < 9); ++nx)
+        {
+          if(++energy[ny * 10 + nx] == 10) pending.push_back(ny * 10 + nx);
+        }
+      }
+    }
+    if(flashed == energy.size()) return true;
+    for(auto& e : energy)
+    {
+      if(e > 9) e = 0;
+    }
+  }
+  return false;
+}
+
+// The octopus grid is fixed at 10x10 by the solver; only the energy levels vary.
+// Grids are redrawn until one synchronizes, so part 2 always terminates.
+inline void dumbo_octo(std::ostream& os, std::ostream&, Rng& rng, size_t)
+{
+  std::array<uint8_t, 100> energy;
+  do
+  {
+    for(auto& e : energy) e = uniform(rng, 0, 9);
+  } while(!dumbo_synchronizes(energy, 10000));
+  write_grid(os, 10, [&](size_t x, size_t y) -> char {
+    return '0' + energy[y * 10 + x];
+  });
+}
+
+// Big caves are never adjacent to each other, otherwise the path count is
+// unbounded. Path counts still grow exponentially with the number of caves.
+inline void pathing(std::ostream& os, std::ostream&, Rng& rng, size_t size)
+{
+  auto name = [](size_t index, char base) {
+    std::string out;
+    do
+    {
+      out.push_back(base + index % 26);
+      index /= 26;
+    } while(out.size() < 2 || index != 0);
+    return out;
+  };
+
+  std::vector<std::string> small, big;
+  for(size_t i = 0; small.size() < std::max<size_t>(size, 2); ++i)
+  {
+    auto cave = name(i, 'a');
+    if(cave != "start" && cave != "end") small.push_back(std::move(cave));
+  }
+  for(size_t i = 0; i < std::max<size_t>(size / 3, 1); ++i) big.push_back(name(i, 'A'));
+
+  std::set<std::pair<std::string, std::string>> edges;
+  auto connect = [&](std::string const& a, std::string const& b) {
+    if(a != b && !edges.contains({b, a})) edges.emplace(a, b);
+  };
+  auto any_small = [&]() -> auto& { return small[uniform(rng, 0, small.size() - 1)]; };
+  for(std::string_view terminal : {"start", "end"})
+  {
+    for(size_t i = 0; i < 2; ++i) connect(std::string(terminal), any_small());
+    connect(std::string(terminal), big[uniform(rng, 0, big.size() - 1)]);
+  }
+  for(size_t i = 1; i < small.size(); ++i)
+  {
+    connect(small[i], small[uniform(rng, 0, i - 1)]);
+  }
+  for(auto const& cave : big)
+  {
+    for(size_t i = 0; i < 3; ++i) connect(cave, any_small());
+  }
+
+  for(auto const& [a, b] : edges) os << a << '-' << b << '\n';
+}
+
+// The paper is (2^k - 1) square and folded in half along each axis until it is 7
+// wide. Fold lines all fall on odd coordinates, so dots only use even ones.
+inline void transparent(std::ostream& os, std::ostream&, Rng& rng, size_t size)
+{
+  size_t side = 7;
+  while((side + 1) * (side + 1) / 4 < 4 * size) side = 2 * side + 1;
+
+  std::set<std::pair<size_t, size_t>> dots{{side - 1, side - 1}};
+  while(dots.size() < std::max<size_t>(size, 1))
+  {
+    dots.emplace(2 * uniform(rng, 0, side / 2), 2 * uniform(rng, 0, side / 2));
+  }
+  for(auto const& [x, y] : dots) os << x << ',' << y << '\n';
+
+  os << '\n';
+  for(auto fold = side / 2; fold >= 7; fold /= 2)
+  {
+    os << "fold along x=" << fold << '\n' << "fold along y=" << fold << '\n';
+  }
+}
+
+inline void polymers(std::ostream& os, std::ostream&, Rng& rng, size_t size)
+{
+  static constexpr std::string_view Elements = "BCFHKNOPSV";
+  auto element = [&]() { return Elements[uniform(rng, 0, Elements.size() - 1)]; };
+  std::string polymer(std::max<size_t>(size, 2), ' ');
+  for(auto& e : polymer) e = element();
+  os << polymer << "\n\n";
+  for(auto a : Elements)
+  {
+    for(auto b : Elements) os << a << b << " -> " << element() << '\n';
+  }
+}
+
+inline void chiton(std::ostream& os, std::ostream&, Rng& rng, size_t size)
+{
+  write_grid(os, size, [&](size_t, size_t) -> char { return '0' + uniform(rng, 1, 9); });
+}
+
+inline void append_bits(std::vector<bool>& bits, uint64_t value, size_t width)
+{
+  for(size_t i = width; i-- > 0;) bits.push_back((value >> i) & 1);
+}
+
+// Emits a packet tree of roughly `budget` packets. Comparison operators take
+// exactly two children; the others take between two and five.
+inline void encode_packet(std::vector<bool>& bits, Rng& rng, size_t budget)
+{
+  append_bits(bits, uniform(rng, 0, 7), 3);
+  if(budget <= 1)
+  {
+    append_bits(bits, 4, 3);
+    auto groups = uniform(rng, 1, 3);
+    for(int64_t g = 0; g < groups; ++g)
+    {
+      append_bits(bits, g + 1 < groups, 1);
+      append_bits(bits, uniform(rng, 0, 15), 4);
+    }
+    return;
+  }
+
+  auto type = uniform(rng, 0, 6);
+  if(type == 4) type = 7;
+  size_t children = type >= 5 ? 2 : std::min<size_t>(uniform(rng, 2, 5), budget - 1);
+  std::vector<bool> body;
+  for(size_t c = 0; c < children; ++c) encode_packet(body, rng, (budget - 1) / children);
+
+  append_bits(bits, type, 3);
+  if(body.size() < (1 << 15) && chance(rng, 0.5))
+  {
+    append_bits(bits, 0, 1);
+    append_bits(bits, body.size(), 15);
+  }
+  else
+  {
+    append_bits(bits, 1, 1);
+    append_bits(bits, children, 11);
+  }
+  bits.insert(bits.end(), body.begin(), body.end());
+}
+
+inline void packet_decoder(std::ostream& os, std::ostream&, Rng& rng, size_t size)
+{
+  std::vector<bool> bits;
+  encode_packet(bits, rng, std::max<size_t>(size, 1));
+  bits.resize((bits.size() + 3) / 4 * 4);
+  static constexpr std::string_view Hex = "0123456789ABCDEF";
+  for(size_t i = 0; i < bits.size(); i += 4)
+  {
+    os << Hex[bits[i] << 3 | bits[i + 1] << 2 | bits[i + 2] << 1 | bits[i + 3]];
+  }
+  os << '\n';
+}
+
+// Numbers are already reduced: no pair nests inside four others and every
+// regular number is a single digit.
+inline void snailfish_number(std::ostream& os, Rng& rng, size_t depth)
+{
+  os << '[';
+  for(size_t side = 0; side < 2; ++side)
+  {
+    if(side == 1) os << ',';
+    if(depth < 4 && chance(rng, 0.6))
+      snailfish_number(os, rng, depth + 1);
+    else
+      os << uniform(rng, 0, 9);
+  }
+  os << ']';
+}
+
+inline void snailfish(std::ostream& os, std::ostream&, Rng& rng, size_t size)
+{
+  for(size_t n = 0; n < size; ++n)
+  {
+    snailfish_number(os, rng, 1);
+    os << '\n';
+  }
+}
+
+using Vec3 = std::array<int64_t, 3>;
+
+// The 24 proper rotations as signed permutation matrices, stored by row.
+inline std::vector<std::array<Vec3, 3>> rotations()
+{
+  std::vector<std::array<Vec3, 3>> out;
+  std::array<size_t, 3> axes{0, 1, 2};
+  do
+  {
+    // An odd permutation flips handedness, which an odd number of sign flips restores.
+    bool odd = (axes[0] > axes[1]) ^ (axes[0] > axes[2]) ^ (axes[1] > axes[2]);
+    for(size_t signs = 0; signs < 8; ++signs)
+    {
+      if((std::popcount(signs) % 2 == 1) != odd) continue;
+      std::array<Vec3, 3> m{};
+      for(size_t row = 0; row < 3; ++row)
+      {
+        m[row][axes[row]] = (signs >> row) & 1 ? -1 : 1;
+      }
+      out.push_back(m);
+    }
+  } while(std::next_permutation(axes.begin(), axes.end()));
+  return out;
+}
+
+// Scanners see a 2000-unit cube. Each scanner after the first is placed near an
+// earlier one and shares exactly 12 beacons from their overlap with it, so the
+// scanners form a tree that a solver can always assemble. Every scanner then
+// reports its beacons in a randomly rotated local frame.
+inline void beacon_scanner(std::ostream& os, std::ostream& truth, Rng& rng, size_t size)
+{
+  constexpr int64_t Range = 1000;
+  size = std::max<size_t>(size, 1);
+  std::vector<Vec3> positions{{0, 0, 0}};
+  std::vector<std::set<Vec3>> seen(size);
+  std::set<Vec3> beacons;
+
+  auto in_box = [&](Vec3 const& lo, Vec3 const& hi) {
+    Vec3 p;
+    for(size_t i = 0; i < 3; ++i) p[i] = uniform(rng, lo[i], hi[i]);
+    return p;
+  };
+  auto cube = [](Vec3 const& center, int64_t delta) {
+    return Vec3{center[0] + delta, center[1] + delta, center[2] + delta};
+  };
+
+  for(size_t s = 1; s < size; ++s)
+  {
+    auto parent = uniform(rng, 0, s - 1);
+    Vec3 pos, lo, hi;
+    for(size_t i = 0; i < 3; ++i)
+    {
+      pos[i] = positions[parent][i] + uniform(rng, -1200, 1200);
+      lo[i] = std::max(pos[i], positions[parent][i]) - Range;
+      hi[i] = std::min(pos[i], positions[parent][i]) + Range;
+    }
+    positions.push_back(pos);
+    for(size_t n = 0; n < 12;)
+    {
+      auto p = in_box(lo, hi);
+      if(!beacons.insert(p).second) continue;
+      seen[parent].insert(p);
+      seen[s].insert(p);
+      ++n;
+    }
+  }
+  for(size_t s = 0; s < size; ++s)
+  {
+    auto target = seen[s].size() + uniform(rng, 13, 16);
+    while(seen[s].size() < target)
+    {
+      auto p = in_box(cube(positions[s], -Range), cube(positions[s], Range));
+      if(beacons.insert(p).second) seen[s].insert(p);
+    }
+  }
+
+  auto const all_rotations = rotations();
+  for(size_t s = 0; s < size; ++s)
+  {
+    auto const& m = all_rotations[s == 0 ? 0 : uniform(rng, 0, all_rotations.size() - 1)];
+    std::vector<Vec3> local;
+    for(auto const& p : seen[s])
+    {
+      Vec3 rel{p[0] - positions[s][0], p[1] - positions[s][1], p[2] - positions[s][2]};
+      Vec3 q{};
+      for(size_t row = 0; row < 3; ++row)
+      {
+        for(size_t col = 0; col < 3; ++col) q[row] += m[row][col] * rel[col];
+      }
+      local.push_back(q);
+    }
+    std::shuffle(local.begin(), local.end(), rng);
+
+    os << (s == 0 ? "" : "\n") << "--- scanner " << s << " ---\n";
+    for(auto const& q : local) os << q[0] << ',' << q[1] << ',' << q[2] << '\n';
+  }
+
+  int64_t widest = 0;
+  for(auto const& a : positions)
+  {
+    for(auto const& b : positions)
+    {
+      widest = std::max(widest, std::abs(a[0] - b[0]) + std::abs(a[1] - b[1]) +
+                                    std::abs(a[2] - b[2]));
+    }
+  }
+  truth << "beacons " << beacons.size() << "\nlargest scanner distance " << widest
+        << '\n';
+}
+
+// Like the puzzle input, the algorithm lights the void on odd steps and darkens it
+// again on even ones.
+inline void trench_map(std::ostream& os, std::ostream&, Rng& rng, size_t size)
+{
+  std::string algorithm(512, '.');
+  for(auto& c : algorithm) c = chance(rng, 0.5) ? '#' : '.';
+  algorithm.front() = '#';
+  algorithm.back() = '.';
+  os << algorithm << "\n\n";
+  write_grid(os, size,
+             [&](size_t, size_t) -> char { return chance(rng, 0.5) ? '#' : '.'; });
+}
+
+inline void sea_cucumbers(std::ostream& os, std::ostream&, Rng& rng, size_t size)
+{
+  std::discrete_distribution<size_t> pick{4, 3, 3};
+  write_grid(os, size, [&](size_t, size_t) { return ".>v"[pick(rng)]; });
+}
+}  // namespace detail
+
+inline std::map<uint32_t, Generator> const& generators()
+{
+  static std::map<uint32_t, Generator> const all{
+      {1, {"depths", 2000, detail::sonar}},
+      {2, {"commands", 1000, detail::controls}},
+      {3, {"diagnostics", 1000, detail::diagnostics}},
+      {4, {"cards", 100, detail::bingo}},
+      {5, {"lines", 500, detail::vents}},
+      {6, {"fish", 300, detail::lanternfish}},
+      {7, {"crabs", 1000, detail::whales}},
+      {8, {"displays", 200, detail::segments}},
+      {9, {"grid side", 100, detail::basin}},
+      {10, {"lines", 100, detail::navigation}},
+      {11, {"ignored (fixed 10x10 grid)", 10, detail::dumbo_octo}},
+      {12, {"small caves", 7, detail::pathing}},
+      {13, {"dots", 800, detail::transparent}},
+      {14, {"template length", 20, detail::polymers}},
+      {15, {"grid side", 100, detail::chiton}},
+      {16, {"packets", 300, detail::packet_decoder}},
+      {18, {"numbers", 100, detail::snailfish}},
+      {19, {"scanners", 30, detail::beacon_scanner}},
+      {20, {"image side", 100, detail::trench_map}},
+      {25, {"grid side", 140, detail::sea_cucumbers}},
+  };
+  return all;
+}
+}  // namespace aoc::gen
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <new>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace aoc
+{
+// Hands out storage aligned to a cache line so the first row of a grid never
+// straddles two lines.
+template <typename T, size_t Alignment = 64>
+struct AlignedAllocator
+{
+  using value_type = T;
+
+  template <typename U>
+  struct rebind
+  {
+    using other = AlignedAllocator<U, Alignment>;
+  };
+
+  AlignedAllocator() = default;
+  template <typename U>
+  constexpr AlignedAllocator(AlignedAllocator<U, Alignment> const&) noexcept
+  {
+  }
+
+  T* allocate(size_t n)
+  {
+    return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+  }
+
+  void deallocate(T* p, size_t) noexcept
+  {
+    ::operator delete(p, std::align_val_t(Alignment));
+  }
+
+  template <typename U>
+  bool operator==(AlignedAllocator<U, Alignment> const&) const noexcept
+  {
+    return true;
+  }
+};
+
+// A dense 2D grid stored row-major. An optional border of `border` cells on every
+// side lets interior cells reach their neighbours through fixed index offsets
+// with no bounds checks; the border is filled like the interior and is otherwise
+// the owner's to use (e.g. as a sentinel). Coordinates passed to operator() are
+// interior coordinates, so (-1, -1) is valid when the border is at least 1.
+template <typename T>
+class Grid
+{
+  // std::vector<bool> is not contiguous; store flags as uint8_t instead.
+  static_assert(!std::is_same_v<T, bool>, "Grid<bool> is not supported");
+
+ public:
+  using value_type = T;
+
+  Grid() = default;
+  Grid(size_t width, size_t height, T fill = T{}, size_t border = 0)
+    : _width(width),
+      _height(height),
+      _border(border),
+      _stride(width + 2 * border),
+      _cells(_stride * (height + 2 * border), fill)
+  {
+    auto s = static_cast<ptrdiff_t>(_stride);
+    _offsets4 = {-s, -1, 1, s};
+    _offsets8 = {-s - 1, -s, -s + 1, -1, 1, s - 1, s, s + 1};
+  }
+
+  size_t width() const { return _width; }
+  size_t height() const { return _height; }
+  size_t size() const { return _width * _height; }
+  size_t border() const { return _border; }
+  size_t stride() const { return _stride; }
+
+  // Storage index of an interior coordinate; border cells have negative or
+  // out-of-range interior coordinates.
+  size_t index(ptrdiff_t x, ptrdiff_t y) const
+  {
+    return (y + _border) * _stride + (x + _border);
+  }
+  ptrdiff_t offset(ptrdiff_t dx, ptrdiff_t dy) const
+  {
+    return dy * static_cast<ptrdiff_t>(_stride) + dx;
+  }
+
+  T& operator()(ptrdiff_t x, ptrdiff_t y) { return _cells[index(x, y)]; }
+  T const& operator()(ptrdiff_t x, ptrdiff_t y) const { return _cells[index(x, y)]; }
+
+  T& at(size_t x, size_t y)
+  {
+    if(x >= _width || y >= _height) throw std::out_of_range("Grid coordinate");
+    return (*this)(x, y);
+  }
+  T const& at(size_t x, size_t y) const
+  {
+    if(x >= _width || y >= _height) throw std::out_of_range("Grid coordinate");
+    return (*this)(x, y);
+  }
+
+  // Raw storage access, for use with index() and the neighbour offsets.
+  T& operator[](size_t index) { return _cells[index]; }
+  T const& operator[](size_t index) const { return _cells[index]; }
+  T* data() { return _cells.data(); }
+  T const* data() const { return _cells.data(); }
+
+  // Orthogonal neighbours (up, left, right, down) and all eight neighbours in
+  // row-major order, as offsets from a storage index.
+  std::array<ptrdiff_t, 4> const& offsets4() const { return _offsets4; }
+  std::array<ptrdiff_t, 8> const& offsets8() const { return _offsets8; }
+
+  std::span<T> row(size_t y) { return {&_cells[index(0, y)], _width}; }
+  std::span<T const> row(size_t y) const { return {&_cells[index(0, y)], _width}; }
+
+  auto column(size_t x) { return strided(&_cells[index(x, 0)], _height, _stride); }
+  auto column(size_t x) const
+  {
+    return strided(&_cells[index(x, 0)], _height, _stride);
+  }
+
+  // Calls f(x, y, index) for every interior cell in storage order.
+  template <typename F>
+  void for_each(F&& f) const
+  {
+    for(size_t y = 0; y < _height; ++y)
+    {
+      auto idx = index(0, y);
+      for(size_t x = 0; x < _width; ++x, ++idx) f(x, y, idx);
+    }
+  }
+
+  template <typename Pred>
+  size_t count_if(Pred&& pred) const
+  {
+    size_t count = 0;
+    for(size_t y = 0; y < _height; ++y)
+    {
+      for(auto const& cell : row(y))
+      {
+        if(pred(cell)) ++count;
+      }
+    }
+    return count;
+  }
+
+  // Sets every cell, border included.
+  void fill(T const& value) { std::fill(_cells.begin(), _cells.end(), value); }
+
+  void fill_border(T const& value)
+  {
+    for(ptrdiff_t y = -ptrdiff_t(_border); y < ptrdiff_t(_height + _border); ++y)
+    {
+      for(ptrdiff_t x = -ptrdiff_t(_border); x < ptrdiff_t(_width + _border); ++x)
+      {
+        if(x < 0 || y < 0 || x >= ptrdiff_t(_width) || y >= ptrdiff_t(_height))
+        {
+          (*this)(x, y) = value;
+        }
+      }
+    }
+  }
+
+  template <typename Format>
+  void print(Format&& format, std::ostream& os = std::cout) const
+  {
+    for(size_t y = 0; y < _height; ++y)
+    {
+      for(auto const& cell : row(y)) os << format(cell);
+      os << std::endl;
+    }
+    os << std::endl;
+  }
+
+ private:
+  template <typename P>
+  static auto strided(P first, size_t count, size_t stride)
+  {
+    return std::views::iota(size_t(0), count) |
+           std::views::transform(
+               [first, stride](size_t n) -> decltype(auto) { return first[n * stride]; });
+  }
+
+  size_t _width = 0;
+  size_t _height = 0;
+  size_t _border = 0;
+  size_t _stride = 0;
+  std::vector<T, AlignedAllocator<T>> _cells;
+  std::array<ptrdiff_t, 4> _offsets4{};
+  std::array<ptrdiff_t, 8> _offsets8{};
+};
+}  // namespace aoc
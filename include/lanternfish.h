@@ -1,61 +1,303 @@
 #pragma once
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <iostream>
 #include <map>
 #include <numeric>
-#include <valarray>
+#include <span>
+#include <string>
 #include <vector>
 
 #include "parse.h"
+#include "registry.h"
+#include "util.h"
 
 namespace aoc
 {
 static constexpr uint32_t SpawnCycle = 7;
 static constexpr uint32_t SpawnDelay = 2;
+static constexpr uint32_t NumTimers = SpawnCycle + SpawnDelay;
+
+// Fish counts indexed by timer, and a linear map from one such vector to another.
+template <typename T>
+using TimerCounts = std::array<T, NumTimers>;
+template <typename T>
+using TimerMatrix = std::array<TimerCounts<T>, NumTimers>;
+
+// Exact while the population fits in 128 bits, which holds for roughly the first
+// thousand days; the counts wrap modulo 2^128 after that.
+struct WideArithmetic
+{
+  using Value = unsigned __int128;
+
+  constexpr Value from(uint64_t count) const { return count; }
+  constexpr Value add(Value a, Value b) const { return a + b; }
+  constexpr Value mul(Value a, Value b) const { return a * b; }
+};
+
+// Counts modulo Modulus, for day counts whose population has no exact representation.
+struct ModularArithmetic
+{
+  using Value = uint64_t;
+
+  uint64_t Modulus;
+
+  constexpr Value from(uint64_t count) const { return count % Modulus; }
+  // Both operands are already reduced.
+  constexpr Value add(Value a, Value b) const
+  {
+    return a >= Modulus - b ? a - (Modulus - b) : a + b;
+  }
+  constexpr Value mul(Value a, Value b) const
+  {
+    return static_cast<Value>(static_cast<unsigned __int128>(a) * b % Modulus);
+  }
+};
+
+// One day as a matrix: entry [to][from] is how many fish with timer `to` each fish
+// with timer `from` becomes. A fish at 0 resets to SpawnCycle - 1 and spawns one at
+// NumTimers - 1; every other fish counts down.
+template <typename T>
+inline constexpr TimerMatrix<T> DayTransition = [] {
+  TimerMatrix<T> m{};
+  for(uint32_t from = 1; from < NumTimers; ++from) m[from - 1][from] = 1;
+  m[SpawnCycle - 1][0] = 1;
+  m[NumTimers - 1][0] = 1;
+  return m;
+}();
+
+template <typename Arithmetic>
+constexpr auto multiply(TimerMatrix<typename Arithmetic::Value> const& a,
+                        TimerMatrix<typename Arithmetic::Value> const& b,
+                        Arithmetic const& arith)
+{
+  TimerMatrix<typename Arithmetic::Value> c{};
+  for(uint32_t i = 0; i < NumTimers; ++i)
+  {
+    for(uint32_t k = 0; k < NumTimers; ++k)
+    {
+      if(a[i][k] == 0) continue;
+      for(uint32_t j = 0; j < NumTimers; ++j)
+      {
+        c[i][j] = arith.add(c[i][j], arith.mul(a[i][k], b[k][j]));
+      }
+    }
+  }
+  return c;
+}
 
+template <typename Arithmetic>
+constexpr auto apply(TimerMatrix<typename Arithmetic::Value> const& m,
+                     TimerCounts<typename Arithmetic::Value> const& v,
+                     Arithmetic const& arith)
+{
+  TimerCounts<typename Arithmetic::Value> out{};
+  for(uint32_t i = 0; i < NumTimers; ++i)
+  {
+    for(uint32_t j = 0; j < NumTimers; ++j)
+    {
+      out[i] = arith.add(out[i], arith.mul(m[i][j], v[j]));
+    }
+  }
+  return out;
+}
+
+// Fast-forwards the counts by squaring the day transition, so any number of days
+// costs O(log days) matrix products.
+template <typename Arithmetic = WideArithmetic>
+constexpr auto fast_forward(TimerCounts<uint64_t> const& timers, uint64_t days,
+                            Arithmetic arith = {})
+{
+  using Value = typename Arithmetic::Value;
+  TimerCounts<Value> counts;
+  for(uint32_t t = 0; t < NumTimers; ++t) counts[t] = arith.from(timers[t]);
+  auto step = DayTransition<Value>;
+  for(; days > 0; days >>= 1)
+  {
+    if(days & 1) counts = apply(step, counts, arith);
+    if(days > 1) step = multiply(step, step, arith);
+  }
+  return counts;
+}
+
+template <typename Arithmetic = WideArithmetic>
+constexpr auto population_after(TimerCounts<uint64_t> const& timers, uint64_t days,
+                                Arithmetic arith = {})
+{
+  typename Arithmetic::Value total = 0;
+  for(auto count : fast_forward(timers, days, arith)) total = arith.add(total, count);
+  return total;
+}
+
+// Fish counts by timer kept in a ring: the slot at _head holds the fish at timer 0
+// and the following slots hold increasing timers. Advancing the head turns the
+// spawning fish into the newborns at timer NumTimers - 1 without moving them, so
+// a day is one add, for the parents rejoining at SpawnCycle - 1, and one increment.
 struct School
 {
-  size_t size() const { return _fish_in_cycle.sum() + _fish_in_delay.sum(); }
+  size_t size() const { return std::accumulate(_fish.begin(), _fish.end(), size_t{0}); }
 
-  void add_fish_to_cycle(uint32_t cycle) { _fish_in_cycle[cycle]++; }
+  void add_fish_to_cycle(uint32_t cycle) { _fish[slot(cycle)]++; }
 
   size_t pass_days(size_t days)
   {
-    for(auto i = 0; i < days; ++i)
+    for(size_t i = 0; i < days; ++i)
     {
-      auto toSpawn = _fish_in_cycle[0];
-      _fish_in_cycle = _fish_in_cycle.cshift(1);
-      _fish_in_cycle[SpawnCycle - 1] += _fish_in_delay[0];
-      _fish_in_delay = _fish_in_delay.shift(1);
-      _fish_in_delay[SpawnDelay - 1] = toSpawn;
+      _fish[slot(SpawnCycle)] += _fish[_head];
+      if(++_head == NumTimers) _head = 0;
     }
 
     return size();
   }
 
+  TimerCounts<uint64_t> timers() const
+  {
+    TimerCounts<uint64_t> counts{};
+    for(uint32_t t = 0; t < NumTimers; ++t) counts[t] = _fish[slot(t)];
+    return counts;
+  }
+
+  // Population after a number of days from now, leaving the school unchanged.
+  template <typename Arithmetic = WideArithmetic>
+  typename Arithmetic::Value population_after(uint64_t days, Arithmetic arith = {}) const
+  {
+    return aoc::population_after(timers(), days, arith);
+  }
+
  private:
-  std::valarray<size_t> _fish_in_cycle = std::valarray<size_t>(SpawnCycle);
-  std::valarray<size_t> _fish_in_delay = std::valarray<size_t>(SpawnDelay);
+  uint32_t slot(uint32_t timer) const { return (_head + timer) % NumTimers; }
+
+  TimerCounts<uint64_t> _fish{};
+  uint32_t _head = 0;
 };
 
-inline School parse_school()
+namespace detail
 {
-  auto input = open_input("./inputs/6-1.txt");
-  std::string line;
-  School school;
-  while(std::getline(input, line))
+inline void add_lanes_scalar(uint64_t* dst, uint64_t const* src, size_t n)
+{
+  for(size_t i = 0; i < n; ++i) dst[i] += src[i];
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("avx2"))) inline void add_lanes_avx2(uint64_t* dst,
+                                                           uint64_t const* src, size_t n)
+{
+  size_t i = 0;
+  for(; i + 4 <= n; i += 4)
+  {
+    auto* d = reinterpret_cast<__m256i*>(dst + i);
+    auto s = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(src + i));
+    _mm256_storeu_si256(d, _mm256_add_epi64(_mm256_loadu_si256(d), s));
+  }
+  add_lanes_scalar(dst + i, src + i, n - i);
+}
+#endif
+
+using AddLanes = void (*)(uint64_t*, uint64_t const*, size_t);
+
+inline AddLanes select_add_lanes()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_cpu_init();
+  if(__builtin_cpu_supports("avx2")) return add_lanes_avx2;
+#endif
+  return add_lanes_scalar;
+}
+
+inline void add_lanes(uint64_t* dst, uint64_t const* src, size_t n)
+{
+  static auto const add = select_add_lanes();
+  add(dst, src, n);
+}
+}  // namespace detail
+
+// Independent schools advanced in lock step. Every school's ring has the same head,
+// so the counts are stored slot by slot with one lane per school and a day is a
+// single vector add across all lanes.
+class SchoolBatch
+{
+ public:
+  explicit SchoolBatch(std::span<TimerCounts<uint64_t> const> schools)
+      : _lanes(schools.size()), _fish(NumTimers * schools.size())
+  {
+    for(size_t lane = 0; lane < _lanes; ++lane)
+    {
+      for(uint32_t t = 0; t < NumTimers; ++t) row(t)[lane] = schools[lane][t];
+    }
+  }
+
+  size_t size() const { return _lanes; }
+
+  // Runs every day on one block of lanes before moving to the next, so the block's
+  // nine rows stay in L1 for the whole run.
+  void pass_days(size_t days)
   {
-    std::istringstream iss(line);
-    while(!iss.eof())
+    constexpr size_t BlockLanes = 256;
+    for(size_t first = 0; first < _lanes; first += BlockLanes)
     {
-      uint32_t cycle;
-      iss >> cycle;
-      school.add_fish_to_cycle(cycle);
-      iss.ignore(1, ',');
+      auto n = std::min(BlockLanes, _lanes - first);
+      auto head = _head;
+      for(size_t i = 0; i < days; ++i)
+      {
+        detail::add_lanes(row(slot(head, SpawnCycle)) + first, row(head) + first, n);
+        if(++head == NumTimers) head = 0;
+      }
     }
+    _head = (_head + days) % NumTimers;
+  }
+
+  uint64_t population(size_t lane) const
+  {
+    uint64_t total = 0;
+    for(uint32_t t = 0; t < NumTimers; ++t) total += row(t)[lane];
+    return total;
+  }
+
+  std::vector<uint64_t> populations() const
+  {
+    std::vector<uint64_t> totals(_lanes);
+    for(uint32_t t = 0; t < NumTimers; ++t)
+    {
+      detail::add_lanes(totals.data(), row(t), _lanes);
+    }
+    return totals;
+  }
+
+ private:
+  static uint32_t slot(uint32_t head, uint32_t timer)
+  {
+    return (head + timer) % NumTimers;
+  }
+
+  uint64_t* row(uint32_t slot) { return _fish.data() + slot * _lanes; }
+  uint64_t const* row(uint32_t slot) const { return _fish.data() + slot * _lanes; }
+
+  size_t _lanes;
+  std::vector<uint64_t> _fish;
+  uint32_t _head = 0;
+};
+
+inline School parse_school(std::string const& path = "./inputs/6-1.txt")
+{
+  InputView input(path);
+  School school;
+  for(auto cycle : parse_uints(input.contents()))
+  {
+    school.add_fish_to_cycle(cycle);
   }
 
   return school;
 }
+
+AOC_REGISTER_DAY(
+    6, "Lanternfish", "./inputs/6-1.txt",
+    [](std::string const& path) { return parse_school(path); },
+    [](School& school) { return school.pass_days(80); },
+    [](School& school) { return to_string(school.population_after(256)); });
 }  // namespace aoc
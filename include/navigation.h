@@ -6,10 +6,12 @@
 #include <map>
 #include <stack>
 #include <string>
+#include <string_view>
 #include <variant>
 #include <vector>
 
 #include "parse.h"
+#include "registry.h"
 
 namespace aoc
 {
@@ -48,8 +50,8 @@ struct Invalid
 using ParseResult = std::variant<Chunk, Incomplete, Invalid>;
 using Line = std::list<ParseResult>;
 
-static inline ParseResult build_chunk(std::string::iterator& it,
-                                      std::string::iterator const& end)
+static inline ParseResult build_chunk(std::string_view::iterator& it,
+                                      std::string_view::iterator const& end)
 {
   std::stack<Chunk> toks;
   toks.emplace(*it++);
@@ -128,12 +130,11 @@ struct Lines
   std::list<Line> _lines;
 };
 
-static inline Lines parse_navigation()
+static inline Lines parse_navigation(std::string const& path = "./inputs/10-1.txt")
 {
-  auto input = open_input("./inputs/10-1.txt");
-  std::string line;
+  InputView input(path);
   Lines lines;
-  while(std::getline(input, line))
+  for(auto line : input.lines())
   {
     auto& l = lines.add_line();
     auto it = line.begin();
@@ -145,4 +146,10 @@ static inline Lines parse_navigation()
 
   return lines;
 }
+
+AOC_REGISTER_DAY(
+    10, "Syntax Scoring", "./inputs/10-1.txt",
+    [](std::string const& path) { return parse_navigation(path); },
+    [](Lines& lines) { return lines.corrupted_score(); },
+    [](Lines& lines) { return lines.autocomplete_score(); });
 }  // namespace aoc
@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "parse.h"
+#include "registry.h"
 
 namespace aoc
 {
@@ -180,6 +181,7 @@ struct Packet
       case PacketType::EqualTo:
         return Subpackets()[0].Value() == Subpackets()[1].Value() ? 1 : 0;
     }
+    throw std::out_of_range("unknown packet type");
   }
 
   PacketHeader Header;
@@ -249,14 +251,15 @@ inline std::bitset<NumBitsPerHex> parse_char(char c)
   return std::bitset<NumBitsPerHex>(c - 'A' + 10);
 }
 
-inline Packet parse_hex()
+inline Packet parse_hex(std::string const& path = "./inputs/16-1.txt")
 {
-  auto input = open_input("./inputs/16-1.txt");
-  std::array<char, 1> digit;
+  InputView input(path);
+  auto hex = input.cursor().line();
   std::vector<bool> bits;
-  while(input.read(digit.data(), 1) && digit[0] != '\n')
+  bits.reserve(hex.size() * NumBitsPerHex);
+  for(auto digit : hex)
   {
-    auto bs = parse_char(digit[0]);
+    auto bs = parse_char(digit);
     for(auto i = NumBitsPerHex - 1; i >= 0; --i)
     {
       bits.push_back(bs[i]);
@@ -264,4 +267,10 @@ inline Packet parse_hex()
   }
   return Packet(bits);
 }
+
+AOC_REGISTER_DAY(
+    16, "Packet Decoder", "./inputs/16-1.txt",
+    [](std::string const& path) { return parse_hex(path); },
+    [](Packet& packet) { return packet.VersionSum(); },
+    [](Packet& packet) { return packet.Value(); });
 }  // namespace aoc
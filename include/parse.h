@@ -1,16 +1,438 @@
 #pragma once
 
-#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <sstream>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
 
 namespace aoc
 {
-inline std::ifstream open_input(std::string const& name)
+inline bool is_space(char c)
+{
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+inline std::string_view trim(std::string_view sv)
+{
+  while(!sv.empty() && is_space(sv.front())) sv.remove_prefix(1);
+  while(!sv.empty() && is_space(sv.back())) sv.remove_suffix(1);
+  return sv;
+}
+
+// Parses a whole (whitespace-trimmed) token as a number, mirroring the
+// semantics of `iss >> value` without constructing a stream.
+template <typename T>
+T to_number(std::string_view sv)
 {
-  std::ifstream input(name);
-  if(!input.is_open()) throw std::out_of_range("Failed to open input file");
-  return input;
+  sv = trim(sv);
+  T value{};
+  auto [ptr, ec] = std::from_chars(sv.data(), sv.data() + sv.size(), value);
+  if(ec != std::errc() || ptr == sv.data())
+    throw std::out_of_range("Failed to parse number");
+  return value;
 }
+
+// Lazily splits a view on a delimiter. As with std::getline, a trailing
+// delimiter does not produce a final empty token.
+struct Split
+{
+  struct Iterator
+  {
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::string_view;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::string_view const*;
+    using reference = std::string_view const&;
+
+    Iterator() = default;
+    Iterator(std::string_view rest, char delim)
+      : _rest(rest), _delim(delim), _done(false)
+    {
+      advance();
+    }
+
+    reference operator*() const { return _token; }
+    pointer operator->() const { return &_token; }
+
+    Iterator& operator++()
+    {
+      advance();
+      return *this;
+    }
+
+    Iterator operator++(int)
+    {
+      auto copy = *this;
+      advance();
+      return copy;
+    }
+
+    bool operator==(Iterator const& other) const
+    {
+      return _done == other._done && (_done || _rest.data() == other._rest.data());
+    }
+
+   private:
+    void advance()
+    {
+      if(_rest.empty())
+      {
+        _done = true;
+        return;
+      }
+      auto end = _rest.find(_delim);
+      _token = _rest.substr(0, end);
+      _rest.remove_prefix(end == std::string_view::npos ? _rest.size() : end + 1);
+    }
+
+    std::string_view _rest;
+    std::string_view _token;
+    char _delim = '\n';
+    bool _done = true;
+  };
+
+  Split(std::string_view text, char delim) : _text(text), _delim(delim) {}
+
+  Iterator begin() const { return Iterator(_text, _delim); }
+  Iterator end() const { return Iterator(); }
+
+ private:
+  std::string_view _text;
+  char _delim;
+};
+
+// Sequential reader over a view, standing in for the `>>`/`ignore`/`getline`
+// calls the parsers previously made against an istringstream.
+struct Cursor
+{
+  explicit Cursor(std::string_view text) : _rest(text) {}
+
+  bool done() const { return _rest.empty(); }
+  std::string_view rest() const { return _rest; }
+  char peek() const { return _rest.empty() ? '\0' : _rest.front(); }
+
+  void skip(size_t n) { _rest.remove_prefix(std::min(n, _rest.size())); }
+
+  void skip_ws()
+  {
+    while(!_rest.empty() && is_space(_rest.front())) _rest.remove_prefix(1);
+  }
+
+  // Consumes up to (and including) the delimiter, returning what preceded it.
+  std::string_view until(char delim)
+  {
+    auto end = _rest.find(delim);
+    auto token = _rest.substr(0, end);
+    _rest.remove_prefix(end == std::string_view::npos ? _rest.size() : end + 1);
+    return token;
+  }
+
+  std::string_view line() { return until('\n'); }
+
+  // Skips leading whitespace like `operator>>`, then parses a number.
+  template <typename T>
+  T number()
+  {
+    skip_ws();
+    T value{};
+    auto [ptr, ec] = std::from_chars(_rest.data(), _rest.data() + _rest.size(), value);
+    if(ec != std::errc() || ptr == _rest.data())
+      throw std::out_of_range("Failed to parse number");
+    _rest.remove_prefix(ptr - _rest.data());
+    return value;
+  }
+
+ private:
+  std::string_view _rest;
+};
+
+namespace detail
+{
+// Converts the digits in [first, last) without re-validating them; the caller has
+// already established that every byte is a digit.
+inline uint32_t convert_digits(char const* first, char const* last, char const* limit)
+{
+  auto len = static_cast<size_t>(last - first);
+  if(len <= 8 && first + 8 <= limit)
+  {
+    // SWAR: left-pad the token with '0' bytes inside a single 64-bit word and fold
+    // pairs, quads and octets of digits together with three multiplies.
+    uint64_t word;
+    std::memcpy(&word, first, sizeof(word));
+    auto pad = (8 - len) * 8;
+    if(pad != 0) word = (word << pad) | (0x3030303030303030ull >> (64 - pad));
+    word = ((word & 0x0F0F0F0F0F0F0F0Full) * 2561) >> 8;
+    word = ((word & 0x00FF00FF00FF00FFull) * 6553601) >> 16;
+    word = ((word & 0x0000FFFF0000FFFFull) * 42949672960001ull) >> 32;
+    return static_cast<uint32_t>(word);
+  }
+
+  uint64_t value = 0;
+  for(; first != last; ++first)
+  {
+    value = value * 10 + (*first - '0');
+    if(value > std::numeric_limits<uint32_t>::max())
+      throw std::out_of_range("Failed to parse number");
+  }
+  return static_cast<uint32_t>(value);
+}
+
+inline uint64_t digit_mask_scalar(char const* p, size_t n)
+{
+  uint64_t mask = 0;
+  for(size_t i = 0; i < n; ++i)
+  {
+    mask |= static_cast<uint64_t>(static_cast<unsigned char>(p[i] - '0') < 10) << i;
+  }
+  return mask;
+}
+
+// Walks the input in 64-byte blocks, using MaskFn to classify each full block into
+// a digit bitmask. Token starts and ends are derived from the mask with shifts and
+// visited with bit scans, so the per-byte work is entirely vectorized. A token
+// left open at the end of a block is closed by the first end bit of the next.
+template <typename MaskFn>
+[[gnu::always_inline]] inline void scan_uints(std::string_view text,
+                                              std::vector<uint32_t>& out, MaskFn mask_fn)
+{
+  constexpr size_t BlockSize = 64;
+  auto const* data = text.data();
+  auto const* limit = data + text.size();
+  auto n = text.size();
+  uint64_t carry = 0;
+  char const* pending = nullptr;
+  for(size_t base = 0; base < n; base += BlockSize)
+  {
+    auto len = std::min(BlockSize, n - base);
+    auto mask =
+        len == BlockSize ? mask_fn(data + base) : digit_mask_scalar(data + base, len);
+    auto shifted = (mask << 1) | carry;
+    carry = mask >> 63;
+    auto starts = mask & ~shifted;
+    auto ends = ~mask & shifted;
+
+    auto const* block = data + base;
+    if(pending != nullptr && ends != 0)
+    {
+      out.push_back(convert_digits(pending, block + std::countr_zero(ends), limit));
+      ends &= ends - 1;
+      pending = nullptr;
+    }
+    while(starts != 0)
+    {
+      auto const* first = block + std::countr_zero(starts);
+      starts &= starts - 1;
+      if(ends == 0)
+      {
+        pending = first;
+        break;
+      }
+      out.push_back(convert_digits(first, block + std::countr_zero(ends), limit));
+      ends &= ends - 1;
+    }
+  }
+  if(pending != nullptr) out.push_back(convert_digits(pending, limit, limit));
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+struct DigitMaskSse
+{
+  __attribute__((target("sse4.2"))) uint64_t operator()(char const* p) const
+  {
+    auto const zero = _mm_set1_epi8('0');
+    auto const nine = _mm_set1_epi8(9);
+    uint64_t mask = 0;
+    for(size_t i = 0; i < 4; ++i)
+    {
+      auto v = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(p + i * 16)),
+                            zero);
+      auto digits = _mm_cmpeq_epi8(_mm_min_epu8(v, nine), v);
+      mask |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(digits)))
+              << (i * 16);
+    }
+    return mask;
+  }
+};
+
+struct DigitMaskAvx2
+{
+  __attribute__((target("avx2"))) uint64_t operator()(char const* p) const
+  {
+    auto const zero = _mm256_set1_epi8('0');
+    auto const nine = _mm256_set1_epi8(9);
+    auto const* v = reinterpret_cast<__m256i const*>(p);
+    auto lo = _mm256_sub_epi8(_mm256_loadu_si256(v), zero);
+    auto hi = _mm256_sub_epi8(_mm256_loadu_si256(v + 1), zero);
+    auto lo_digits = _mm256_cmpeq_epi8(_mm256_min_epu8(lo, nine), lo);
+    auto hi_digits = _mm256_cmpeq_epi8(_mm256_min_epu8(hi, nine), hi);
+    return static_cast<uint32_t>(_mm256_movemask_epi8(lo_digits)) |
+           static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(hi_digits)))
+               << 32;
+  }
+};
+
+__attribute__((target("sse4.2"))) inline void scan_uints_sse(std::string_view text,
+                                                              std::vector<uint32_t>& out)
+{
+  scan_uints(text, out, DigitMaskSse());
+}
+
+__attribute__((target("avx2"))) inline void scan_uints_avx2(std::string_view text,
+                                                             std::vector<uint32_t>& out)
+{
+  scan_uints(text, out, DigitMaskAvx2());
+}
+#endif
+
+inline void scan_uints_scalar(std::string_view text, std::vector<uint32_t>& out)
+{
+  auto const* p = text.data();
+  auto const* limit = p + text.size();
+  while(p != limit)
+  {
+    if(static_cast<unsigned char>(*p - '0') >= 10)
+    {
+      ++p;
+      continue;
+    }
+    auto const* first = p;
+    while(p != limit && static_cast<unsigned char>(*p - '0') < 10) ++p;
+    out.push_back(convert_digits(first, p, limit));
+  }
+}
+
+using ScanUints = void (*)(std::string_view, std::vector<uint32_t>&);
+
+inline ScanUints select_scan_uints()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_cpu_init();
+  if(__builtin_cpu_supports("avx2")) return scan_uints_avx2;
+  if(__builtin_cpu_supports("sse4.2")) return scan_uints_sse;
+#endif
+  return scan_uints_scalar;
+}
+}  // namespace detail
+
+// Appends every run of decimal digits in the text to `out`; any other byte acts
+// as a separator. The widest kernel the CPU supports is chosen on first use.
+inline void parse_uints(std::string_view text, std::vector<uint32_t>& out)
+{
+  static auto const scan = detail::select_scan_uints();
+  scan(text, out);
+}
+
+inline std::vector<uint32_t> parse_uints(std::string_view text)
+{
+  std::vector<uint32_t> out;
+  out.reserve(text.size() / 4);
+  parse_uints(text, out);
+  return out;
+}
+
+// Read-only view of an entire input file. Regular files are memory mapped so that
+// parsers can hand out string_views into the file without copying; anything that
+// can't be mapped (pipes, empty files) is read into an owned buffer instead.
+class InputView
+{
+ public:
+  explicit InputView(std::string const& name)
+  {
+    auto fd = ::open(name.c_str(), O_RDONLY);
+    if(fd < 0) throw std::out_of_range("Failed to open input file");
+
+    struct stat st;
+    if(::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+    {
+      auto* mapped = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if(mapped != MAP_FAILED)
+      {
+        ::madvise(mapped, st.st_size, MADV_SEQUENTIAL);
+        _mapped = mapped;
+        _size = st.st_size;
+      }
+    }
+
+    if(_mapped == nullptr)
+    {
+      char buf[1 << 16];
+      ssize_t n;
+      while((n = ::read(fd, buf, sizeof(buf))) > 0) _buffer.append(buf, n);
+      if(n < 0)
+      {
+        ::close(fd);
+        throw std::system_error(errno, std::generic_category(),
+                                "Failed to read input file");
+      }
+    }
+
+    ::close(fd);
+    rebind();
+  }
+
+  InputView(InputView const&) = delete;
+  InputView& operator=(InputView const&) = delete;
+
+  InputView(InputView&& other) noexcept { swap(other); }
+  InputView& operator=(InputView&& other) noexcept
+  {
+    swap(other);
+    return *this;
+  }
+
+  ~InputView()
+  {
+    if(_mapped != nullptr) ::munmap(_mapped, _size);
+  }
+
+  std::string_view contents() const { return _contents; }
+  size_t size() const { return _contents.size(); }
+
+  Split lines() const { return Split(_contents, '\n'); }
+  Cursor cursor() const { return Cursor(_contents); }
+
+ private:
+  void swap(InputView& other) noexcept
+  {
+    std::swap(_mapped, other._mapped);
+    std::swap(_size, other._size);
+    std::swap(_buffer, other._buffer);
+    rebind();
+    other.rebind();
+  }
+
+  void rebind()
+  {
+    _contents = _mapped != nullptr
+                    ? std::string_view(static_cast<char const*>(_mapped), _size)
+                    : std::string_view(_buffer);
+  }
+
+  void* _mapped = nullptr;
+  size_t _size = 0;
+  std::string _buffer;
+  std::string_view _contents;
+};
 }  // namespace aoc
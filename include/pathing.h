@@ -6,11 +6,12 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
-#include <unordered_map>
-#include <unordered_set>
+#include <string_view>
 #include <vector>
 
+#include "flat_map.h"
 #include "parse.h"
+#include "registry.h"
 
 namespace aoc
 {
@@ -39,7 +40,7 @@ struct Cave
 struct Path
 {
   std::vector<std::string> Caves;
-  std::unordered_set<std::string> Visited;
+  FlatSet<std::string> Visited;
   bool SmallRevisited = false;
 };
 
@@ -53,12 +54,12 @@ struct CaveSystem
 
   size_t num_caves() const { return _caves.size(); }
 
-  void add_path(std::string const& start, std::string const& end)
+  void add_path(std::string_view start, std::string_view end)
   {
-    auto& s = get_cave(start);
-    auto& e = get_cave(end);
-    s.add_path(e.Name);
-    e.add_path(s.Name);
+    // Inserting a cave can rehash _caves, so no reference is held across an insert.
+    get_cave(start);
+    get_cave(end).add_path(std::string(start));
+    get_cave(start).add_path(std::string(end));
   }
 
   std::vector<Path> unique_paths() const { return sub_paths(start(), {}); }
@@ -90,8 +91,9 @@ struct CaveSystem
     return paths;
   }
 
-  Cave& get_cave(std::string const& cave)
+  Cave& get_cave(std::string_view name)
   {
+    std::string cave(name);
     auto it = _caves.find(cave);
     if(it != _caves.end()) return it->second;
 
@@ -99,25 +101,26 @@ struct CaveSystem
     return inserted->second;
   }
 
-  std::unordered_map<std::string, Cave> _caves;
+  FlatMap<std::string, Cave> _caves;
 };
 
-inline CaveSystem parse_cave_system()
+inline CaveSystem parse_cave_system(std::string const& path = "./inputs/12-1.txt")
 {
-  auto input = open_input("./inputs/12-1.txt");
+  InputView input(path);
   CaveSystem system;
-  std::string line;
-  while(std::getline(input, line))
+  for(auto line : input.lines())
   {
-    std::string start, end;
-    std::istringstream iss(line);
-    if(!std::getline(iss, start, '-'))
+    auto sep = line.find('-');
+    if(sep == std::string_view::npos)
       throw std::out_of_range("Failed to parse start of path");
-    iss >> end;
-    system.add_path(start, end);
+    system.add_path(line.substr(0, sep), trim(line.substr(sep + 1)));
   }
 
   return system;
 }
 
+AOC_REGISTER_DAY(
+    12, "Passage Pathing", "./inputs/12-1.txt",
+    [](std::string const& path) { return parse_cave_system(path); }, nullptr,
+    [](CaveSystem& system) { return system.unique_paths().size(); });
 }  // namespace aoc
@@ -4,17 +4,18 @@
 #include <cstddef>
 #include <stdexcept>
 #include <string>
-#include <unordered_map>
 #include <valarray>
 
+#include "flat_map.h"
 #include "parse.h"
+#include "registry.h"
 #include "util.h"
 
 namespace aoc
 {
 using PolymerTemplate = std::string;
-using InsertionRules = std::unordered_map<std::pair<char, char>, char, pair_hash>;
-using Step = std::unordered_map<std::pair<char, char>, size_t, pair_hash>;
+using InsertionRules = FlatMap<std::pair<char, char>, char, pair_hash>;
+using Step = FlatMap<std::pair<char, char>, size_t, pair_hash>;
 
 struct PolymerFormula
 {
@@ -39,7 +40,7 @@ struct PolymerFormula
   size_t score(size_t steps)
   {
     auto step = run_steps(steps);
-    std::unordered_map<char, size_t> occurs;
+    FlatMap<char, size_t> occurs;
     for(auto const& [pair, count] : step)
     {
       occurs[pair.first] += count;
@@ -71,29 +72,28 @@ struct PolymerFormula
   Step _temp;
 };
 
-inline PolymerFormula parse_polymer()
+inline PolymerFormula parse_polymer(std::string const& path = "./inputs/14-1.txt")
 {
-  auto input = open_input("./inputs/14-1.txt");
+  InputView input(path);
+  auto cursor = input.cursor();
   PolymerFormula formula;
-  std::string line;
-  if(!std::getline(input, formula.Template))
-    throw std::out_of_range("Failed to parse template");
-  input.ignore(1, '\n');
+  if(cursor.done()) throw std::out_of_range("Failed to parse template");
+  formula.Template = cursor.line();
+  cursor.skip(1);
 
-  std::array<char, 2> key;
-  while(std::getline(input, line))
+  while(!cursor.done())
   {
-    std::pair<char, char> key;
-    char value;
-    std::istringstream iss(line);
-    iss.get(key.first);
-    iss.get(key.second);
-    iss.ignore(4);
-    iss.get(value);
-    formula.Rules.try_emplace(std::move(key), value);
+    auto line = cursor.line();
+    std::pair<char, char> key{line.at(0), line.at(1)};
+    formula.Rules.try_emplace(std::move(key), line.at(6));
   }
 
   return formula;
 }
 
+AOC_REGISTER_DAY(
+    14, "Extended Polymerization", "./inputs/14-1.txt",
+    [](std::string const& path) { return parse_polymer(path); },
+    [](PolymerFormula& formula) { return formula.score(10); },
+    [](PolymerFormula& formula) { return formula.score(40); });
 }  // namespace aoc
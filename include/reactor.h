@@ -52,7 +52,8 @@ struct Cuboid
     }
     else
     {
-      return {smaller.second - larger.first + 1, {larger.first, smaller.second}};
+      return {static_cast<size_t>(smaller.second - larger.first + 1),
+              {larger.first, smaller.second}};
     }
   }
 
@@ -257,29 +258,27 @@ inline std::ostream& operator<<(std::ostream& os, Cuboid const& instr)
   return os;
 }
 
-inline Reactor parse_reactor()
+inline Reactor parse_reactor(std::string const& path = "inputs/22-1.txt")
 {
-  auto input = open_input("inputs/22-1.txt");
+  InputView input(path);
   Reactor reactor;
-  std::string line, token;
-  while(std::getline(input, line))
+  for(auto line : input.lines())
   {
-    std::istringstream iss(line);
+    Cursor cursor(line);
     auto& instruction = reactor.AddInstruction();
-    std::getline(iss, token, ' ');
-    instruction.on = token == "on";
-    iss.ignore(2);
-    iss >> instruction.x_range.first;
-    iss.ignore(2);
-    iss >> instruction.x_range.second;
-    iss.ignore(3);
-    iss >> instruction.y_range.first;
-    iss.ignore(2);
-    iss >> instruction.y_range.second;
-    iss.ignore(3);
-    iss >> instruction.z_range.first;
-    iss.ignore(2);
-    iss >> instruction.z_range.second;
+    instruction.on = cursor.until(' ') == "on";
+    cursor.skip(2);
+    instruction.x_range.first = cursor.number<int32_t>();
+    cursor.skip(2);
+    instruction.x_range.second = cursor.number<int32_t>();
+    cursor.skip(3);
+    instruction.y_range.first = cursor.number<int32_t>();
+    cursor.skip(2);
+    instruction.y_range.second = cursor.number<int32_t>();
+    cursor.skip(3);
+    instruction.z_range.first = cursor.number<int32_t>();
+    cursor.skip(2);
+    instruction.z_range.second = cursor.number<int32_t>();
   }
 
   return reactor;
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace aoc
+{
+// A registered puzzle. Parse produces an opaque handle that the part solvers
+// consume, so callers can time the two phases separately without knowing the
+// concrete type each day parses into. Unimplemented parts are left empty, as is
+// Copy when the parsed state cannot be copied.
+struct Day
+{
+  using Parsed = std::shared_ptr<void>;
+  using Part = std::function<std::string(Parsed const&)>;
+
+  uint32_t Number;
+  std::string Name;
+  std::string Input;
+  std::function<Parsed(std::string const&)> Parse;
+  std::function<Parsed(Parsed const&)> Copy;
+  std::array<Part, 2> Parts;
+
+  bool HasPart(size_t part) const { return part >= 1 && part <= 2 && Parts[part - 1]; }
+
+  std::string Solve(size_t part, Parsed const& parsed) const
+  {
+    if(!HasPart(part)) throw std::out_of_range("Part is not implemented");
+    return Parts[part - 1](parsed);
+  }
+};
+
+using Registry = std::map<uint32_t, Day>;
+
+inline Registry& registry()
+{
+  static Registry days;
+  return days;
+}
+
+namespace detail
+{
+template <typename T, typename Solver>
+Day::Part make_part(Solver solver)
+{
+  if constexpr(std::is_null_pointer_v<Solver>)
+  {
+    return {};
+  }
+  else
+  {
+    return [solver](Day::Parsed const& parsed) {
+      std::ostringstream oss;
+      oss << solver(*std::static_pointer_cast<T>(parsed));
+      return oss.str();
+    };
+  }
+}
+
+template <typename T>
+std::function<Day::Parsed(Day::Parsed const&)> make_copy()
+{
+  if constexpr(std::is_copy_constructible_v<T>)
+  {
+    return [](Day::Parsed const& parsed) -> Day::Parsed {
+      return std::make_shared<T>(*std::static_pointer_cast<T>(parsed));
+    };
+  }
+  else
+  {
+    return {};
+  }
+}
+}  // namespace detail
+
+// Parse takes the input path and returns the day's state by value; each part
+// takes that state by reference and returns anything printable. Pass nullptr
+// for a part that has not been solved.
+template <typename ParseFn, typename Part1, typename Part2>
+bool register_day(uint32_t number, std::string name, std::string input, ParseFn parse,
+                  Part1 part1, Part2 part2)
+{
+  using T = std::invoke_result_t<ParseFn, std::string const&>;
+  Day day{number, std::move(name), std::move(input),
+          [parse](std::string const& path) -> Day::Parsed {
+            return std::make_shared<T>(parse(path));
+          },
+          detail::make_copy<T>(),
+          {detail::make_part<T>(std::move(part1)),
+           detail::make_part<T>(std::move(part2))}};
+  auto [_, inserted] = registry().emplace(number, std::move(day));
+  if(!inserted) throw std::out_of_range("Day registered more than once");
+  return inserted;
+}
+}  // namespace aoc
+
+#define AOC_REGISTER_DAY(number, ...) \
+  inline bool const registered_day_##number = ::aoc::register_day(number, __VA_ARGS__)
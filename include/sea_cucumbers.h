@@ -1,13 +1,15 @@
 #pragma once
 
-#include <cassert>
 #include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <ranges>
 #include <string>
-#include <valarray>
 #include <vector>
 
+#include "grid.h"
 #include "parse.h"
-#include "util.h"
+#include "registry.h"
 
 namespace aoc
 {
@@ -35,94 +37,44 @@ inline std::ostream& operator<<(std::ostream& os, Cucumber const& c)
   return os;
 }
 
+// Works a whole row or column at a time: a herd member moves when the cell ahead
+// of it (wrapping around) was empty before the herd started moving.
 struct FastField
 {
-  FastField(size_t width, size_t height)
-    : _width(width), _height(height), _field(width * height)
+  FastField(size_t width, size_t height) : _field(width, height, Cucumber::Nonexistant)
   {
   }
 
   void Populate(std::vector<Cucumber> const& cucumbers)
   {
-    for(size_t n = 0; n < cucumbers.size(); ++n)
+    auto it = cucumbers.begin();
+    for(size_t y = 0; y < _field.height(); ++y)
     {
-      int8_t val;
-      switch(cucumbers[n])
-      {
-        case Cucumber::Nonexistant:
-          val = 0;
-          break;
-        case Cucumber::East:
-          val = 1;
-          break;
-        case Cucumber::South:
-          val = 3;
-          break;
-      }
-      _field[n / _width * _width + n % _width] = val;
+      for(auto& cell : _field.row(y)) cell = *it++;
     }
   }
 
   void Print() const
   {
-    for(auto n = 0; n < _width * _height; ++n)
-    {
-      char c = 'O';
-      switch(_field[n])
-      {
-        case 0:
-          c = '.';
-          break;
-        case 1:
-          c = '>';
-          break;
-        case 3:
-          c = 'v';
-          break;
-      }
-
-      std::cout << c;
-      if((n + 1) % _width == 0) std::cout << std::endl;
-    }
-    std::cout << std::endl;
-  }
-
-  std::slice_array<int8_t> row(size_t n)
-  {
-    return _field[std::slice(n * _width, _width, 1)];
+    _field.print([](Cucumber c) { return c; });
   }
 
-  std::slice_array<int8_t> col(size_t n)
-  {
-    return _field[std::slice(n, _height, _width)];
-  }
-
-  int8_t move_east()
+  size_t move_east()
   {
     size_t moves = 0;
-    for(size_t n = 0; n < _height; ++n)
+    for(size_t y = 0; y < _field.height(); ++y)
     {
-      std::valarray<int8_t> r = row(n);
-      r = r.cshift(-1) + r;
-      r = r.apply([](int8_t v) -> int8_t { return v == 1 ? 1 : 0; });
-      moves += r.sum();
-      r = r.cshift(1) * -1 + r;
-      row(n) += r;
+      moves += move_herd(_field.row(y), Cucumber::East);
     }
     return moves;
   }
 
-  int8_t move_south()
+  size_t move_south()
   {
     size_t moves = 0;
-    for(size_t n = 0; n < _width; ++n)
+    for(size_t x = 0; x < _field.width(); ++x)
     {
-      std::valarray<int8_t> r = col(n);
-      r = r.cshift(-1) + r;
-      r = r.apply([](int8_t v) -> int8_t { return v == 3 ? 3 : 0; });
-      moves += r.sum();
-      r = r.cshift(1) * -1 + r;
-      col(n) += r;
+      moves += move_herd(_field.column(x), Cucumber::South);
     }
     return moves;
   }
@@ -144,91 +96,103 @@ struct FastField
   }
 
  private:
-  size_t _width;
-  size_t _height;
-  std::valarray<int8_t> _field;
+  template <typename Line>
+  static size_t move_herd(Line&& line, Cucumber herd)
+  {
+    auto size = std::ranges::size(line);
+    if(size == 0) return 0;
+    // The first cell may be filled by the last one, so remember whether it was free.
+    bool first_empty = line[0] == Cucumber::Nonexistant;
+    size_t moves = 0;
+    for(size_t n = 0; n < size; ++n)
+    {
+      auto next = n + 1 == size ? 0 : n + 1;
+      bool next_empty = next == 0 ? first_empty : line[next] == Cucumber::Nonexistant;
+      if(line[n] == herd && next_empty)
+      {
+        line[n] = Cucumber::Nonexistant;
+        line[next] = herd;
+        ++moves;
+        ++n;
+      }
+    }
+    return moves;
+  }
+
+  Grid<Cucumber> _field;
 };
 
 struct CucumberField
 {
   CucumberField(size_t width, size_t height)
-    : _width(width), _height(height), _cucumbers(width * height)
+    : _cucumbers(width, height, Cucumber::Nonexistant)
   {
   }
 
   void Populate(std::vector<Cucumber> const& cucumbers)
   {
-    for(size_t n = 0; n < cucumbers.size(); ++n)
+    auto it = cucumbers.begin();
+    for(size_t y = 0; y < _cucumbers.height(); ++y)
     {
-      _cucumbers[n / _width * _width + n % _width] = cucumbers[n];
+      for(auto& c : _cucumbers.row(y)) c = *it++;
     }
   }
 
-  void Print() const { aoc::print_matrix(_cucumbers, _width); }
+  void Print() const
+  {
+    _cucumbers.print([](Cucumber c) { return c; });
+  }
 
   size_t CountMoves()
   {
     size_t num_steps = 0;
     size_t num_moved = 0;
-    std::valarray<uint8_t> east_moves(_width * _height), south_moves(_width * _height);
+    Grid<uint8_t> east_moves(width(), height()), south_moves(width(), height());
     do
     {
-      east_moves = east_moves.apply([](uint8_t _) -> uint8_t { return 0; });
-      south_moves = south_moves.apply([](uint8_t _) -> uint8_t { return 0; });
       num_steps++;
-
-      for(auto h = 0; h < _height; ++h)
-      {
-        for(auto w = 0; w < _width; ++w)
-        {
-          east_moves[h * _width + w] = ShouldMove(Cucumber::East, w, h);
-        }
-      }
-      ApplyMoves(east_moves);
-      for(auto h = 0; h < _height; ++h)
-      {
-        for(auto w = 0; w < _width; ++w)
-        {
-          south_moves[h * _width + w] = ShouldMove(Cucumber::South, w, h);
-        }
-      }
-      ApplyMoves(south_moves);
-    } while(east_moves.sum() + south_moves.sum() > 0);
+      _cucumbers.for_each([&](size_t w, size_t h, size_t idx) {
+        east_moves[idx] = ShouldMove(Cucumber::East, w, h);
+      });
+      num_moved = ApplyMoves(east_moves);
+      _cucumbers.for_each([&](size_t w, size_t h, size_t idx) {
+        south_moves[idx] = ShouldMove(Cucumber::South, w, h);
+      });
+      num_moved += ApplyMoves(south_moves);
+    } while(num_moved > 0);
 
     return num_steps;
   }
 
-  void ApplyMoves(std::valarray<uint8_t> const& moves)
+  size_t ApplyMoves(Grid<uint8_t> const& moves)
   {
+    size_t num_moved = 0;
     auto prev = _cucumbers;
-    for(auto h = 0; h < _height; ++h)
-    {
-      for(auto w = 0; w < _width; ++w)
+    prev.for_each([&](size_t w, size_t h, size_t idx) {
+      if(!moves[idx]) return;
+      ++num_moved;
+      auto to_move = prev[idx];
+      at(w, h) = Cucumber::Nonexistant;
+      if(to_move == Cucumber::East)
       {
-        auto idx = h * _width + w;
-        if(!moves[idx]) continue;
-        auto to_move = prev[idx];
-        at(w, h) = Cucumber::Nonexistant;
-        if(to_move == Cucumber::East)
-        {
-          at(w + 1, h) = to_move;
-        }
-        else
-        {
-          at(w, h + 1) = to_move;
-        }
+        at(w + 1, h) = to_move;
       }
-    }
+      else
+      {
+        at(w, h + 1) = to_move;
+      }
+    });
+    return num_moved;
   }
 
   Cucumber& at(size_t width, size_t height)
   {
-    return _cucumbers[(width % _width) + _width * (height % _height)];
+    return _cucumbers(width % this->width(), height % this->height());
   }
 
   Cucumber const& at(size_t width, size_t height) const
   {
-    return _cucumbers[(width % _width) + _width * (height % _height)];
+    return _cucumbers(width % this->width(), height % this->height());
   }
 
   uint8_t ShouldMove(Cucumber direction, size_t width, size_t height) const
@@ -249,18 +213,19 @@ struct CucumberField
   }
 
  private:
-  size_t _width;
-  size_t _height;
-  std::valarray<Cucumber> _cucumbers;
+  size_t width() const { return _cucumbers.width(); }
+  size_t height() const { return _cucumbers.height(); }
+
+  Grid<Cucumber> _cucumbers;
 };
 
-inline FastField parse_fast_cucumbers()
+inline FastField parse_fast_cucumbers(std::string const& path = "./inputs/25-1.txt")
 {
-  auto input = open_input("./inputs/25-1.txt");
+  InputView input(path);
   std::vector<Cucumber> cucumbers;
-  std::string line;
+  cucumbers.reserve(input.size());
   size_t width = 0, height = 0;
-  while(std::getline(input, line))
+  for(auto line : input.lines())
   {
     ++height;
     width = line.size();
@@ -288,13 +253,13 @@ inline FastField parse_fast_cucumbers()
   return field;
 }
 
-inline CucumberField parse_cucumbers()
+inline CucumberField parse_cucumbers(std::string const& path = "./inputs/25-1.txt")
 {
-  auto input = open_input("./inputs/25-1.txt");
+  InputView input(path);
   std::vector<Cucumber> cucumbers;
-  std::string line;
+  cucumbers.reserve(input.size());
   size_t width = 0, height = 0;
-  while(std::getline(input, line))
+  for(auto line : input.lines())
   {
     ++height;
     width = line.size();
@@ -321,4 +286,9 @@ inline CucumberField parse_cucumbers()
   field.Populate(cucumbers);
   return field;
 }
+
+AOC_REGISTER_DAY(
+    25, "Sea Cucumber", "./inputs/25-1.txt",
+    [](std::string const& path) { return parse_cucumbers(path); },
+    [](CucumberField& field) { return field.CountMoves(); }, nullptr);
 }  // namespace aoc
@@ -9,9 +9,11 @@
 #include <numeric>
 #include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "parse.h"
+#include "registry.h"
 
 namespace aoc
 {
@@ -20,7 +22,7 @@ struct Segment
   Segment() = default;
   Segment(std::bitset<8> bs) : _signals(bs) {}
 
-  void enable_signals(std::string const& signals)
+  void enable_signals(std::string_view signals)
   {
     for(auto c : signals)
     {
@@ -49,13 +51,13 @@ static const std::set<size_t> UniqueSegments{2, 3, 4, 7};
 
 struct Note
 {
-  void add_input(std::string input)
+  void add_input(std::string_view input)
   {
     auto& s = _inputs.emplace_back();
     s.enable_signals(input);
   }
 
-  void add_output(std::string output)
+  void add_output(std::string_view output)
   {
     auto& s = _outputs.emplace_back();
     s.enable_signals(output);
@@ -153,29 +155,31 @@ struct Notes
   std::vector<Note> _notes;
 };
 
-inline Notes parse_segment_notes()
+inline Notes parse_segment_notes(std::string const& path = "./inputs/8-1.txt")
 {
-  auto input = open_input("./inputs/8-1.txt");
-  std::string line;
+  InputView input(path);
   Notes notes;
-  std::string entry;
-  while(std::getline(input, line))
+  for(auto line : input.lines())
   {
     auto& s = notes.add_note();
-    std::istringstream iss(line);
+    Cursor cursor(line);
     for(auto i = 0; i < 10; ++i)
     {
-      std::getline(iss, entry, ' ');
-      s.add_input(entry);
+      s.add_input(cursor.until(' '));
     }
-    iss.ignore(2, ' ');
+    cursor.skip(2);
     for(auto i = 0; i < 4; ++i)
     {
-      std::getline(iss, entry, ' ');
-      s.add_output(entry);
+      s.add_output(cursor.until(' '));
     }
   }
 
   return notes;
 }
+
+AOC_REGISTER_DAY(
+    8, "Seven Segment Search", "./inputs/8-1.txt",
+    [](std::string const& path) { return parse_segment_notes(path); },
+    [](Notes& notes) { return notes.unique_output_segments(); },
+    [](Notes& notes) { return notes.total(); });
 }  // namespace aoc
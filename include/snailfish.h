@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "parse.h"
+#include "registry.h"
 
 namespace aoc
 {
@@ -391,12 +392,11 @@ inline Number parse_single_number(std::string_view num_str)
   return number;
 }
 
-inline std::vector<Number> parse_numbers()
+inline std::vector<Number> parse_numbers(std::string const& path = "./inputs/18-1.txt")
 {
-  auto input = aoc::open_input("./inputs/18-1.txt");
+  InputView input(path);
   std::vector<Number> numbers;
-  std::string line;
-  while(std::getline(input, line))
+  for(auto line : input.lines())
   {
     numbers.emplace_back(parse_single_number(line));
   }
@@ -444,4 +444,12 @@ inline std::pair<size_t, Number> greatest_binary_magnitude(std::vector<Number> n
   }
   return {mag, greatest};
 }
+
+AOC_REGISTER_DAY(
+    18, "Snailfish", "./inputs/18-1.txt",
+    [](std::string const& path) { return parse_numbers(path); },
+    [](std::vector<Number>& numbers) { return magnitude(std::move(numbers)).first; },
+    [](std::vector<Number>& numbers) {
+      return greatest_binary_magnitude(std::move(numbers)).first;
+    });
 }  // namespace aoc
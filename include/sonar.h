@@ -1,71 +1,295 @@
 #pragma once
 
+#include <fcntl.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
 #include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <iterator>
 #include <ranges>
 #include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 #include <system_error>
+#include <thread>
 #include <vector>
 
+#include "parse.h"
+#include "registry.h"
 #include "util.h"
 
 namespace aoc
 {
 using SonarReadings = std::vector<uint32_t>;
 
-inline SonarReadings parse_sonar_readings()
+inline SonarReadings parse_sonar_readings(std::string const& path = "./inputs/1-1.txt")
+{
+  InputView input(path);
+  return parse_uints(input.contents());
+}
+
+namespace detail
 {
-  std::ifstream input("./inputs/1-1.txt", std::ios::binary);
-  if(!input.is_open())
+// Each kernel counts the i < n with lo[i] < hi[i]. Comparing a series against
+// itself shifted by w counts the increases over windows of size w.
+inline size_t count_increases_scalar(uint32_t const* lo, uint32_t const* hi, size_t n)
+{
+  size_t result = 0;
+  for(size_t i = 0; i < n; ++i)
   {
-    throw std::system_error(std::make_error_code(std::errc::io_error),
-                            "Failed to open input file");
+    if(lo[i] < hi[i]) ++result;
   }
-  std::istream_iterator<uint32_t> it(input);
-  SonarReadings result(it, std::istream_iterator<uint32_t>());
   return result;
 }
 
+#if defined(__x86_64__) || defined(__i386__)
+// There is no unsigned 32-bit compare below AVX-512, so both sides are biased into
+// signed range first. Matches are accumulated as -1 per lane and summed at the end
+// rather than popcounted per vector, which keeps the loop free of scalar work;
+// a lane wraps only after 2^32 vectors.
+__attribute__((target("sse4.2"))) inline __m128i load_biased_sse(uint32_t const* p)
+{
+  auto v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+  return _mm_xor_si128(v, _mm_set1_epi32(INT32_MIN));
+}
+
+__attribute__((target("sse4.2"))) inline size_t count_increases_sse(uint32_t const* lo,
+                                                                    uint32_t const* hi,
+                                                                    size_t n)
+{
+  auto acc = _mm_setzero_si128();
+  size_t i = 0;
+  for(; i + 4 <= n; i += 4)
+  {
+    auto a = load_biased_sse(lo + i);
+    auto b = load_biased_sse(hi + i);
+    acc = _mm_sub_epi32(acc, _mm_cmpgt_epi32(b, a));
+  }
+  alignas(16) uint32_t lanes[4];
+  _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+  size_t result = 0;
+  for(auto lane : lanes) result += lane;
+  return result + count_increases_scalar(lo + i, hi + i, n - i);
+}
+
+__attribute__((target("avx2"))) inline __m256i load_biased_avx2(uint32_t const* p)
+{
+  auto v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p));
+  return _mm256_xor_si256(v, _mm256_set1_epi32(INT32_MIN));
+}
+
+// Two accumulators, so consecutive compares don't wait on each other's subtract.
+__attribute__((target("avx2"))) inline size_t count_increases_avx2(uint32_t const* lo,
+                                                                   uint32_t const* hi,
+                                                                   size_t n)
+{
+  __m256i acc[2] = {_mm256_setzero_si256(), _mm256_setzero_si256()};
+  size_t i = 0;
+  for(; i + 16 <= n; i += 16)
+  {
+    for(size_t k = 0; k < 2; ++k)
+    {
+      auto a = load_biased_avx2(lo + i + k * 8);
+      auto b = load_biased_avx2(hi + i + k * 8);
+      acc[k] = _mm256_sub_epi32(acc[k], _mm256_cmpgt_epi32(b, a));
+    }
+  }
+  alignas(32) uint32_t lanes[8];
+  size_t result = 0;
+  for(auto const& a : acc)
+  {
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), a);
+    for(auto lane : lanes) result += lane;
+  }
+  return result + count_increases_scalar(lo + i, hi + i, n - i);
+}
+#endif
+
+using CountIncreases = size_t (*)(uint32_t const*, uint32_t const*, size_t);
+
+inline CountIncreases select_count_increases()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_cpu_init();
+  if(__builtin_cpu_supports("avx2")) return count_increases_avx2;
+  if(__builtin_cpu_supports("sse4.2")) return count_increases_sse;
+#endif
+  return count_increases_scalar;
+}
+
+// The widest kernel the CPU supports, chosen on first use.
+inline size_t count_increases(uint32_t const* lo, uint32_t const* hi, size_t n)
+{
+  static auto const count = select_count_increases();
+  return count(lo, hi, n);
+}
+}  // namespace detail
+
 class Sonar
 {
  public:
   explicit Sonar(SonarReadings readings) : _readings(std::move(readings)) {}
 
-  uint32_t depth_increases() const
+  uint64_t depth_increases() const { return depth_increases(1); }
+
+  // Adjacent windows share all but their end readings, so the later sum is larger
+  // exactly when the reading entering it is larger than the one leaving.
+  uint64_t depth_increases(size_t windowSize) const
   {
-    if(_readings.size() <= 1) return 0;
-    auto result = 0;
-    auto fst = _readings.begin();
-    for(auto snd = std::next(fst); snd != _readings.end(); ++fst, ++snd)
+    if(_readings.size() <= windowSize) return 0;
+    auto const* data = _readings.data();
+    auto n = _readings.size() - windowSize;
+    return detail::count_increases(data, data + windowSize, n);
+  }
+
+  // Splits the comparisons into one contiguous chunk per thread. A chunk reads
+  // `windowSize` readings past its own end, so pairs that straddle a boundary are
+  // counted exactly once, by the chunk holding their earlier reading.
+  uint64_t depth_increases(size_t windowSize, size_t threads) const
+  {
+    if(_readings.size() <= windowSize) return 0;
+    auto const* data = _readings.data();
+    auto n = _readings.size() - windowSize;
+    threads = std::clamp<size_t>(threads, 1, std::max<size_t>(n / MinChunk, 1));
+
+    std::vector<size_t> counts(threads);
     {
-      if(*fst < *snd) ++result;
+      std::vector<std::jthread> workers;
+      for(size_t t = 1; t < threads; ++t)
+      {
+        workers.emplace_back([&, t] {
+          auto first = n * t / threads, last = n * (t + 1) / threads;
+          counts[t] = detail::count_increases(data + first, data + first + windowSize,
+                                              last - first);
+        });
+      }
+      counts[0] = detail::count_increases(data, data + windowSize, n / threads);
     }
-
+    uint64_t result = 0;
+    for(auto c : counts) result += c;
     return result;
   }
 
-  uint32_t depth_increases(size_t windowSize) const
+ private:
+  // Below this many comparisons per thread, starting the thread costs more than
+  // the work it takes over.
+  static constexpr size_t MinChunk = 1 << 16;
+
+  SonarReadings _readings;
+};
+
+// Counts depth increases for several window sizes while readings arrive, without
+// holding the series: by the same identity as Sonar::depth_increases(size_t), each
+// window only needs the reading `size` places back, so a ring buffer as long as
+// the largest window is all the state there is.
+class SonarStream
+{
+ public:
+  explicit SonarStream(std::vector<size_t> windows)
+    : _windows(std::move(windows)), _increases(_windows.size(), 0)
+  {
+    if(_windows.empty()) throw std::out_of_range("No window sizes given");
+    if(std::find(_windows.begin(), _windows.end(), 0) != _windows.end())
+      throw std::out_of_range("Window size must be positive");
+    auto largest = *std::max_element(_windows.begin(), _windows.end());
+    _ring.resize(std::bit_ceil(largest));
+    _mask = _ring.size() - 1;
+  }
+
+  void push(uint32_t reading)
   {
-    auto result = 0;
-    auto view = std::span(_readings);
-    for(size_t i = 0; i < _readings.size() - windowSize; ++i)
+    for(size_t i = 0; i < _windows.size(); ++i)
     {
-      auto fst = aoc::sum(view.subspan(i, windowSize));
-      auto snd = aoc::sum(view.subspan(i + 1, windowSize));
-      if(fst < snd) result++;
+      // Branch-free: on noisy data the comparison is a coin flip. Slots not yet
+      // written hold zero-initialised readings and are masked out by the count.
+      auto w = _windows[i];
+      _increases[i] += (_count >= w) & (_ring[(_count - w) & _mask] < reading);
     }
-    return result;
+    _ring[_count & _mask] = reading;
+    ++_count;
   }
 
+  void push(std::span<uint32_t const> readings)
+  {
+    for(auto reading : readings) push(reading);
+  }
+
+  // Reads until end of file in fixed-size chunks, so pipes and files larger than
+  // memory both work. A number split across two reads is carried over.
+  void consume(int fd)
+  {
+    char chunk[1 << 16];
+    std::string pending;
+    std::vector<uint32_t> parsed;
+    ssize_t n;
+    while((n = ::read(fd, chunk, sizeof(chunk))) > 0)
+    {
+      pending.append(chunk, n);
+      auto end = pending.find_last_not_of("0123456789");
+      if(end == std::string::npos) continue;
+      parsed.clear();
+      parse_uints(std::string_view(pending).substr(0, end + 1), parsed);
+      push(parsed);
+      pending.erase(0, end + 1);
+    }
+    if(n < 0)
+      throw std::system_error(errno, std::generic_category(), "Failed to read input");
+    parsed.clear();
+    parse_uints(pending, parsed);
+    push(parsed);
+  }
+
+  void consume(std::string const& path)
+  {
+    auto fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0) throw std::out_of_range("Failed to open input file");
+    try
+    {
+      consume(fd);
+    }
+    catch(...)
+    {
+      ::close(fd);
+      throw;
+    }
+    ::close(fd);
+  }
+
+  uint64_t increases(size_t window) const
+  {
+    auto it = std::find(_windows.begin(), _windows.end(), window);
+    if(it == _windows.end()) throw std::out_of_range("Window size not tracked");
+    return _increases[it - _windows.begin()];
+  }
+
+  size_t readings() const { return _count; }
+
  private:
-  SonarReadings _readings;
+  std::vector<size_t> _windows;
+  std::vector<uint64_t> _increases;
+  std::vector<uint32_t> _ring;
+  size_t _mask = 0;
+  size_t _count = 0;
 };
 
-inline int run_sonar()
+inline uint64_t run_sonar()
 {
   Sonar sonar(parse_sonar_readings());
   return sonar.depth_increases(3);
 }
+
+AOC_REGISTER_DAY(
+    1, "Sonar Sweep", "./inputs/1-1.txt",
+    [](std::string const& path) { return Sonar(parse_sonar_readings(path)); },
+    [](Sonar& sonar) { return sonar.depth_increases(); },
+    [](Sonar& sonar) { return sonar.depth_increases(3); });
 }  // namespace aoc
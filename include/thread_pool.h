@@ -0,0 +1,139 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace aoc
+{
+// A fixed-size pool where every worker owns a deque. Workers take their newest
+// task first and, once idle, steal the oldest task from a sibling. Tasks submitted
+// from inside a worker land on that worker's own deque, so follow-up work stays on
+// the thread whose cache already holds its data unless someone else is idle.
+class ThreadPool
+{
+ public:
+  explicit ThreadPool(size_t threads = std::thread::hardware_concurrency())
+  {
+    threads = std::max<size_t>(threads, 1);
+    for(size_t i = 0; i < threads; ++i) _queues.push_back(std::make_unique<Queue>());
+    for(size_t i = 0; i < threads; ++i) _workers.emplace_back([this, i] { run(i); });
+  }
+
+  ThreadPool(ThreadPool const&) = delete;
+  ThreadPool& operator=(ThreadPool const&) = delete;
+
+  // Finishes every queued task before joining the workers.
+  ~ThreadPool()
+  {
+    {
+      std::lock_guard lock(_wake_mutex);
+      _stopping = true;
+    }
+    _wake.notify_all();
+    _workers.clear();
+  }
+
+  size_t size() const { return _queues.size(); }
+
+  template <typename F>
+  std::future<std::invoke_result_t<F>> submit(F&& f)
+  {
+    using R = std::invoke_result_t<F>;
+    auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(f));
+    auto future = task->get_future();
+    push([task] { (*task)(); });
+    return future;
+  }
+
+ private:
+  using Task = std::function<void()>;
+
+  struct Queue
+  {
+    std::mutex Mutex;
+    std::deque<Task> Tasks;
+  };
+
+  // Identifies the worker running on the current thread, if any.
+  static inline thread_local ThreadPool const* t_pool = nullptr;
+  static inline thread_local size_t t_index = 0;
+
+  void push(Task task)
+  {
+    auto index = t_pool == this ? t_index : _next++ % _queues.size();
+    // Counted before it is published, so a thief's decrement never runs ahead of it.
+    {
+      std::lock_guard lock(_wake_mutex);
+      ++_pending;
+    }
+    {
+      std::lock_guard lock(_queues[index]->Mutex);
+      _queues[index]->Tasks.push_back(std::move(task));
+    }
+    _wake.notify_one();
+  }
+
+  bool try_pop(size_t self, Task& task)
+  {
+    for(size_t n = 0; n < _queues.size(); ++n)
+    {
+      auto& queue = *_queues[(self + n) % _queues.size()];
+      std::lock_guard lock(queue.Mutex);
+      if(queue.Tasks.empty()) continue;
+      if(n == 0)
+      {
+        task = std::move(queue.Tasks.back());
+        queue.Tasks.pop_back();
+      }
+      else
+      {
+        task = std::move(queue.Tasks.front());
+        queue.Tasks.pop_front();
+      }
+      std::lock_guard wake(_wake_mutex);
+      --_pending;
+      return true;
+    }
+    return false;
+  }
+
+  void run(size_t self)
+  {
+    t_pool = this;
+    t_index = self;
+    Task task;
+    while(true)
+    {
+      if(try_pop(self, task))
+      {
+        task();
+        task = nullptr;
+        continue;
+      }
+      std::unique_lock lock(_wake_mutex);
+      _wake.wait(lock, [this] { return _pending > 0 || _stopping; });
+      if(_pending == 0 && _stopping) return;
+    }
+  }
+
+  std::vector<std::unique_ptr<Queue>> _queues;
+  std::mutex _wake_mutex;
+  std::condition_variable _wake;
+  size_t _pending = 0;
+  bool _stopping = false;
+  std::atomic<size_t> _next = 0;
+  // Declared last so the workers stop before the queues they read are destroyed.
+  std::vector<std::jthread> _workers;
+};
+}  // namespace aoc
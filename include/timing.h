@@ -0,0 +1,50 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace aoc
+{
+using Clock = std::chrono::steady_clock;
+using Duration = std::chrono::nanoseconds;
+
+template <typename F>
+Duration time_it(F&& f)
+{
+  auto t1 = Clock::now();
+  f();
+  auto t2 = Clock::now();
+  return std::chrono::duration_cast<Duration>(t2 - t1);
+}
+
+struct Summary
+{
+  Duration Min{};
+  Duration Median{};
+  Duration P99{};
+};
+
+// Nearest-rank percentiles; with fewer than 100 samples p99 is the maximum.
+inline Summary summarize(std::vector<Duration> samples)
+{
+  Summary summary;
+  if(samples.empty()) return summary;
+  std::sort(samples.begin(), samples.end());
+  auto rank = [&samples](double pct) {
+    auto idx = static_cast<size_t>(std::ceil(pct * samples.size()));
+    return samples[std::clamp<size_t>(idx, 1, samples.size()) - 1];
+  };
+  summary.Min = samples.front();
+  summary.Median = rank(0.5);
+  summary.P99 = rank(0.99);
+  return summary;
+}
+
+inline double to_micros(Duration d)
+{
+  return std::chrono::duration<double, std::micro>(d).count();
+}
+}  // namespace aoc
@@ -2,13 +2,15 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <stdexcept>
 #include <utility>
-#include <valarray>
 #include <vector>
 
+#include "grid.h"
 #include "parse.h"
+#include "registry.h"
 
 namespace aoc
 {
@@ -27,10 +29,7 @@ struct Fold
 struct Paper
 {
   Paper() = default;
-  Paper(size_t width, size_t height)
-    : Width(width), Height(height), Size(Width * Height), Marks(Size)
-  {
-  }
+  Paper(size_t width, size_t height) : Marks(width, height) {}
   Paper(size_t width, size_t height, std::vector<std::pair<size_t, size_t>> const& points)
     : Paper(width, height)
   {
@@ -39,86 +38,62 @@ struct Paper
       set(x, y);
     }
   }
-  Paper(size_t width, size_t height, Paper const& originating) : Paper(width, height)
-  {
-    for(auto y = 0; y < Height; ++y)
-    {
-      for(auto x = 0; x < Width; ++x)
-      {
-        if(originating.set(x, y)) set(x, y);
-      }
-    }
-  }
 
+  // Marks on the fold line itself are dropped; the puzzle never places any there.
   Paper fold(Fold const& fold) const
   {
-    Paper folded;
+    auto width = Marks.width(), height = Marks.height();
     if(fold.Direction == FoldDirection::Horizontal)
     {
-      auto new_width = fold.Coord;
-      folded = Paper(new_width, Height, *this);
-      for(auto y = 0; y < Height; ++y)
+      Paper folded(fold.Coord, height);
+      for(size_t y = 0; y < height; ++y)
       {
-        for(auto x = new_width; x < Width; ++x)
+        auto from = Marks.row(y);
+        auto to = folded.Marks.row(y);
+        for(size_t x = 0; x < fold.Coord; ++x) to[x] = from[x];
+        for(auto x = fold.Coord + 1; x < width && x <= 2 * fold.Coord; ++x)
         {
-          if(!set(x, y)) continue;
-          folded.set(new_width - (x - new_width), y);
+          to[2 * fold.Coord - x] |= from[x];
         }
       }
+      return folded;
     }
-    else
+
+    Paper folded(width, fold.Coord);
+    for(size_t y = 0; y < fold.Coord; ++y)
     {
-      auto new_height = fold.Coord;
-      folded = Paper(Width, new_height, *this);
-      for(auto y = new_height; y < Height; ++y)
-      {
-        for(auto x = 0; x < Width; ++x)
-        {
-          if(!set(x, y)) continue;
-          folded.set(x, new_height - (y - new_height));
-        }
-      }
+      std::copy_n(Marks.row(y).begin(), width, folded.Marks.row(y).begin());
+    }
+    for(auto y = fold.Coord + 1; y < height && y <= 2 * fold.Coord; ++y)
+    {
+      auto from = Marks.row(y);
+      auto to = folded.Marks.row(2 * fold.Coord - y);
+      for(size_t x = 0; x < width; ++x) to[x] |= from[x];
     }
     return folded;
   }
 
   void print() const
   {
-    auto w = 0;
-    for(auto val : Marks)
-    {
-      std::cout << (val ? '1' : ' ');
-      if(++w == Width)
-      {
-        w = 0;
-        std::cout << std::endl;
-      }
-    }
-    std::cout << std::endl;
+    Marks.print([](uint8_t m) { return m ? '1' : ' '; });
   }
 
-  void set(size_t x, size_t y) { Marks[y * Width + x] = true; }
-  bool set(size_t x, size_t y) const { return Marks[y * Width + x]; }
+  void set(size_t x, size_t y) { Marks(x, y) = 1; }
+  bool set(size_t x, size_t y) const { return Marks(x, y); }
 
   size_t num_marks() const
   {
-    size_t num = 0;
-    for(auto m : Marks)
-      if(m) ++num;
-    return num;
+    return Marks.count_if([](uint8_t m) { return m != 0; });
   }
 
-  size_t Width;
-  size_t Height;
-  size_t Size;
-  std::valarray<bool> Marks;
+  Grid<uint8_t> Marks;
 };
 
 struct Manual
 {
-  Paper apply_folds() const { return apply_folds(Folds.size()); }
+  aoc::Paper apply_folds() const { return apply_folds(Folds.size()); }
 
-  Paper apply_folds(size_t num) const
+  aoc::Paper apply_folds(size_t num) const
   {
     size_t count = 0;
     auto p = this->Paper;
@@ -131,25 +106,26 @@ struct Manual
     return p;
   }
 
-  Paper Paper;
+  aoc::Paper Paper;
   std::vector<Fold> Folds;
 };
 
-inline Manual parse_manual()
+inline Manual parse_manual(std::string const& path = "./inputs/13-1.txt")
 {
-  auto input = open_input("./inputs/13-1.txt");
-  std::string line, tok;
+  InputView input(path);
+  auto cursor = input.cursor();
   size_t x, y, fold;
   size_t width = 0, height = 0;
   std::vector<std::pair<size_t, size_t>> coords;
-  while(std::getline(input, line))
+  while(!cursor.done())
   {
+    auto line = cursor.line();
     if(line.empty()) break;
-    std::istringstream iss(line);
-    if(!std::getline(iss, tok, ','))
-      throw std::out_of_range("Failed to parse x coordinate");
-    x = std::atoi(tok.c_str());
-    iss >> y;
+    Cursor point(line);
+    x = point.number<size_t>();
+    if(point.peek() != ',') throw std::out_of_range("Failed to parse x coordinate");
+    point.skip(1);
+    y = point.number<size_t>();
     width = std::max(width, x);
     height = std::max(height, y);
     coords.emplace_back(x, y);
@@ -158,16 +134,22 @@ inline Manual parse_manual()
   height++;
 
   std::vector<Fold> folds;
-  while(std::getline(input, line))
+  while(!cursor.done())
   {
-    auto sub = line.substr(11);
+    auto sub = cursor.line().substr(11);
     auto direction = sub.at(0);
-    auto coord = sub.substr(2);
-    fold = std::atoi(coord.c_str());
+    fold = to_number<size_t>(sub.substr(2));
     folds.emplace_back(Fold{
         direction == 'x' ? FoldDirection::Horizontal : FoldDirection::Vertical, fold});
   }
 
   return Manual{Paper(width, height, coords), std::move(folds)};
 }
+
+// Part 2's answer is read off the printed paper; the mark count stands in for it.
+AOC_REGISTER_DAY(
+    13, "Transparent Origami", "./inputs/13-1.txt",
+    [](std::string const& path) { return parse_manual(path); },
+    [](Manual& manual) { return manual.apply_folds(1).num_marks(); },
+    [](Manual& manual) { return manual.apply_folds().num_marks(); });
 }  // namespace aoc
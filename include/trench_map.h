@@ -1,7 +1,6 @@
 #pragma once
 
 #include <array>
-#include <bitset>
 #include <cstddef>
 #include <cstdint>
 #include <iostream>
@@ -10,83 +9,64 @@
 #include <valarray>
 #include <vector>
 
+#include "grid.h"
 #include "parse.h"
-#include "util.h"
+#include "registry.h"
 
 namespace aoc
 {
-static constexpr std::array<std::pair<int8_t, int8_t>, 9> neighbor_offsets()
-{
-  std::array<std::pair<int8_t, int8_t>, 9> offsets;
-  auto n = 0;
-  for(auto y = -1; y <= 1; ++y)
-  {
-    for(auto x = -1; x <= 1; ++x)
-    {
-      offsets[n++] = {x, y};
-    }
-  }
-  return offsets;
-}
-
-static constexpr std::array<std::pair<int32_t, int32_t>, 9> neighbors_of(int32_t x,
-                                                                         int32_t y)
-{
-  std::array<std::pair<int32_t, int32_t>, 9> neighbors;
-  auto n = 0;
-  for(auto const& offset : neighbor_offsets())
-  {
-    neighbors[n++] = {x + offset.first, y + offset.second};
-  }
-  return neighbors;
-}
-
+// Pixels outside the image all share one value, the identity, which the border
+// holds. Two cells of border let every pixel of the next, one-larger image read
+// its 3x3 window without bounds checks.
 struct Image
 {
-  Image(size_t width, size_t height, bool identity)
-    : _width(width), _height(height), _identity(identity), _image(_width * _height)
-  {
-  }
+  static constexpr size_t Border = 2;
 
-  Image(size_t width, size_t height, std::valarray<bool> image)
-    : _width(width), _height(height), _identity(false), _image(std::move(image))
+  Image(size_t width, size_t height, bool identity)
+    : _identity(identity), _image(width, height, 0, Border)
   {
+    _image.fill_border(identity);
   }
 
-  bool GetPixel(int32_t x, int32_t y) const
+  Image(size_t width, size_t height, std::vector<uint8_t> const& pixels)
+    : Image(width, height, false)
   {
-    if(x < 0 || y < 0 || x >= _width || y >= _height)
+    if(pixels.size() != width * height)
+      throw std::out_of_range("Invalid number of pixels");
+    auto it = pixels.begin();
+    for(size_t y = 0; y < height; ++y)
     {
-      return _identity;
+      for(auto& p : _image.row(y)) p = *it++;
     }
-
-    return At(x, y);
   }
 
   size_t LitPixels() const
   {
-    size_t count = 0;
-    for(auto b : _image)
-    {
-      if(b) ++count;
-    }
-    return count;
+    return _image.count_if([](uint8_t p) { return p != 0; });
   }
 
   Image Translate(std::valarray<bool> const& enhancement_algo) const
   {
-    Image translated(_width + 2, _height + 2, NextIdentity(enhancement_algo));
-    std::bitset<9> window;
-    for(auto y = -1; y <= static_cast<int32_t>(_height); ++y)
+    auto width = static_cast<ptrdiff_t>(_image.width());
+    auto height = static_cast<ptrdiff_t>(_image.height());
+    Image translated(width + 2, height + 2, NextIdentity(enhancement_algo));
+
+    std::array<ptrdiff_t, 9> window;
+    auto n = 0;
+    for(auto dy = -1; dy <= 1; ++dy)
     {
-      for(auto x = -1; x <= static_cast<int32_t>(_width); ++x)
+      for(auto dx = -1; dx <= 1; ++dx) window[n++] = _image.offset(dx, dy);
+    }
+
+    for(auto y = -1; y <= height; ++y)
+    {
+      auto idx = _image.index(-1, y);
+      for(auto& out : translated._image.row(y + 1))
       {
-        auto n = 0;
-        for(auto const& neighbor : neighbors_of(x, y))
-        {
-          window.set(8 - n++, GetPixel(neighbor.first, neighbor.second));
-        }
-        translated.At(x + 1, y + 1) = enhancement_algo[window.to_ulong()];
+        size_t bits = 0;
+        for(auto o : window) bits = bits << 1 | _image[idx + o];
+        out = enhancement_algo[bits];
+        ++idx;
       }
     }
     return translated;
@@ -94,30 +74,17 @@ struct Image
 
   void Print() const
   {
-    for(auto y = 0; y < _height; ++y)
-    {
-      for(auto x = 0; x < _width; ++x)
-      {
-        std::cout << (At(x, y) ? '#' : '.');
-      }
-      std::cout << std::endl;
-    }
-    std::cout << std::endl;
+    _image.print([](uint8_t p) { return p ? '#' : '.'; });
   }
 
  private:
-  bool& At(int32_t width, int32_t height) { return _image[height * _width + width]; }
-  bool At(int32_t width, int32_t height) const { return _image[height * _width + width]; }
-
   bool NextIdentity(std::valarray<bool> const& enhancement_algo) const
   {
     return _identity ? enhancement_algo[511] : enhancement_algo[0];
   }
 
-  size_t _width;
-  size_t _height;
   bool _identity = false;
-  std::valarray<bool> _image;
+  Grid<uint8_t> _image;
 };
 
 struct ImageProcessor
@@ -151,37 +118,37 @@ struct ImageProcessor
   std::valarray<bool> _enhancement_algo;
 };
 
-inline ImageProcessor parse_image()
+inline ImageProcessor parse_image(std::string const& path = "./inputs/20-1.txt")
 {
-  auto input = open_input("./inputs/20-1.txt");
+  InputView input(path);
+  auto cursor = input.cursor();
   size_t width = 0, height = 0;
-  std::string line;
-  if(!std::getline(input, line))
-    throw std::out_of_range("Failed to parse enhancement algo");
+  if(cursor.done()) throw std::out_of_range("Failed to parse enhancement algo");
+  auto line = cursor.line();
   std::valarray<bool> enhancement_algo(line.size());
   for(auto n = 0; n < line.size(); ++n)
   {
     enhancement_algo[n] = line[n] == '#' ? true : false;
   }
 
-  std::vector<bool> pixels;
-  while(std::getline(input, line))
+  std::vector<uint8_t> pixels;
+  for(auto line : Split(cursor.rest(), '\n'))
   {
     if(line.empty()) continue;
     height++;
     if(width == 0) width = line.size();
     for(auto c : line)
     {
-      pixels.push_back(c == '#' ? true : false);
+      pixels.push_back(c == '#' ? 1 : 0);
     }
   }
-  std::valarray<bool> initial_image(width * height);
-  for(auto n = 0; n < pixels.size(); ++n)
-  {
-    initial_image[n] = pixels[n];
-  }
 
-  return ImageProcessor(Image(width, height, std::move(initial_image)),
-                        std::move(enhancement_algo));
+  return ImageProcessor(Image(width, height, pixels), std::move(enhancement_algo));
 }
+
+AOC_REGISTER_DAY(
+    20, "Trench Map", "./inputs/20-1.txt",
+    [](std::string const& path) { return parse_image(path); },
+    [](ImageProcessor& processor) { return processor.Enhance(2).LitPixels(); },
+    [](ImageProcessor& processor) { return processor.Enhance(50).LitPixels(); });
 }  // namespace aoc
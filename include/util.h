@@ -1,11 +1,16 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <iostream>
 #include <ostream>
 #include <span>
+#include <string>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -55,6 +60,19 @@ U abs_diff(U fst, U snd)
   return std::abs(static_cast<S>(fst - snd));
 }
 
+// Decimal digits of a 128-bit count, which streams cannot print.
+inline std::string to_string(unsigned __int128 value)
+{
+  std::string digits;
+  do
+  {
+    digits.push_back(static_cast<char>('0' + value % 10));
+    value /= 10;
+  } while(value > 0);
+  std::reverse(digits.begin(), digits.end());
+  return digits;
+}
+
 template <typename T>
 std::ostream& operator<<(std::ostream& os, std::valarray<T> const& v)
 {
@@ -82,58 +100,74 @@ void print_matrix(std::valarray<T> const& v, size_t width)
   std::cout << std::endl;
 }
 
-struct pair_hash
+// Hash combining in the style of wyhash: each element is folded in with a full
+// 64x64->128 bit multiply, so unlike XOR the result depends on element order and
+// equal elements do not cancel. std::hash of an integer is the identity, which
+// this mixing makes safe to use for grid coordinates and small offsets.
+namespace hash
 {
-  template <class T1, class T2>
-  std::size_t operator()(const std::pair<T1, T2>& p) const
-  {
-    auto h1 = std::hash<T1>{}(p.first);
-    auto h2 = std::hash<T2>{}(p.second);
+inline constexpr uint64_t DefaultSeed = 0xa0761d6478bd642full;
 
-    return h1 ^ h2;
-  }
-};
+inline constexpr uint64_t mix(uint64_t a, uint64_t b)
+{
+  auto r = static_cast<unsigned __int128>(a) * b;
+  return static_cast<uint64_t>(r) ^ static_cast<uint64_t>(r >> 64);
+}
+
+inline constexpr uint64_t combine(uint64_t h, uint64_t value)
+{
+  return mix(h ^ 0xe7037ed1a0b428dbull, value ^ 0x8ebc6af09c88c6e3ull);
+}
 
-template <std::size_t Index, typename... T>
-struct tuple_hash_impl
+template <typename T>
+uint64_t element(T const& value)
 {
-  using Tuple = std::tuple<T...>;
+  return std::hash<T>{}(value);
+}
+}  // namespace hash
 
-  std::size_t operator()(Tuple const& t)
+struct pair_hash
+{
+  uint64_t seed = hash::DefaultSeed;
+
+  template <class T1, class T2>
+  std::size_t operator()(const std::pair<T1, T2>& p) const
   {
-    if constexpr(Index == 0)
-    {
-      return std::get<Index>(t);
-    }
-    else
-    {
-      return std::hash<std::tuple_element_t<Index, Tuple>>()(std::get<Index>(t)) ^
-             tuple_hash_impl<Index - 1, T...>()(t);
-    }
+    auto h = hash::combine(seed, hash::element(p.first));
+    return hash::combine(h, hash::element(p.second));
   }
 };
 
 struct tuple_hash
 {
+  uint64_t seed = hash::DefaultSeed;
+
   template <typename... T>
   std::size_t operator()(std::tuple<T...> const& t) const
   {
-    return tuple_hash_impl<std::tuple_size_v<std::tuple<T...>> - 1, T...>()(t);
+    return std::apply(
+        [this](auto const&... elements) {
+          auto h = seed;
+          ((h = hash::combine(h, hash::element(elements))), ...);
+          return h;
+        },
+        t);
   }
 };
 
 struct array_hash
 {
+  uint64_t seed = hash::DefaultSeed;
+
   template <typename T, size_t N>
   std::size_t operator()(std::array<T, N> const& a) const
   {
-    auto hasher = std::hash<T>();
-    size_t result = 0;
+    auto h = seed;
     for(size_t n = 0; n < N; ++n)
     {
-      result ^= hasher(a[n]);
+      h = hash::combine(h, hash::element(a[n]));
     }
-    return result;
+    return h;
   }
 };
 
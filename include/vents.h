@@ -1,14 +1,24 @@
 #pragma once
 
 #include <algorithm>
-#include <cmath>
+#include <array>
 #include <cstdint>
+#include <future>
+#include <limits>
+#include <optional>
+#include <set>
+#include <span>
 #include <sstream>
+#include <stdexcept>
 #include <string>
-#include <valarray>
+#include <tuple>
+#include <utility>
 #include <vector>
 
+#include "grid.h"
 #include "parse.h"
+#include "registry.h"
+#include "thread_pool.h"
 #include "util.h"
 
 namespace aoc
@@ -17,15 +27,6 @@ struct Point
 {
   uint32_t x = 0;
   uint32_t y = 0;
-
-  uint32_t distance(Point const& other) const { return abs_diff(this->x, other.x) + 1; }
-
-  int32_t slope(Point const& other) const
-  {
-    // Slope is inverted from standard cartesian
-    return -1 * static_cast<int32_t>(this->y - other.y) /
-           static_cast<int32_t>(this->x - other.x);
-  }
 };
 
 inline std::istream& operator>>(std::istream& is, Point& point)
@@ -40,25 +41,10 @@ struct Line
 {
   Point start{};
   Point end{};
-
-  std::slice plane_impact(size_t width) const
+  // Number of points covered; lines are horizontal, vertical or at 45 degrees.
+  uint32_t length() const
   {
-    if(start.x == end.x)  // Vertical
-    {
-      return std::slice(start.x + width * std::min(start.y, end.y),
-                        abs_diff(start.y, end.y) + 1, width);
-    }
-    else if(start.y == end.y)  // Horizontal
-    {
-      return std::slice(start.y * width + std::min(start.x, end.x),
-                        abs_diff(start.x, end.x) + 1, 1);
-    }
-
-    // Diagonal
-    auto distance = start.distance(end);
-    auto slope = start.slope(end);
-    auto const& lowest = start.y < end.y ? start : end;
-    return std::slice(lowest.x + lowest.y * width, distance, width - slope);
+    return std::max(abs_diff(start.x, end.x), abs_diff(start.y, end.y)) + 1;
   }
 };
 
@@ -71,6 +57,22 @@ inline std::istream& operator>>(std::istream& is, Line& line)
   return is;
 }
 
+inline Cursor& operator>>(Cursor& cursor, Point& point)
+{
+  point.x = cursor.number<uint32_t>();
+  cursor.skip(1);
+  point.y = cursor.number<uint32_t>();
+  return cursor;
+}
+
+inline Cursor& operator>>(Cursor& cursor, Line& line)
+{
+  cursor >> line.start;
+  cursor.until('>');
+  cursor >> line.end;
+  return cursor;
+}
+
 class Plane
 {
  public:
@@ -92,14 +94,8 @@ class Plane
     _width += 1;
     _height += 1;
 
-    _plane = std::valarray<uint32_t>(size());
-    for(auto const& line : _lines)
-    {
-      auto impact = line.plane_impact(_width);
-      std::valarray<uint32_t> s = _plane[impact];
-      s += 1;
-      _plane[impact] = s;
-    }
+    _plane = Grid<uint32_t>(_width, _height);
+    for(auto const& line : _lines) draw(line);
   }
 
   uint32_t size() const { return _width * _height; }
@@ -108,46 +104,409 @@ class Plane
 
   void print() const
   {
-    for(auto col = 0; col < _height; ++col)
+    _plane.print([](uint32_t v) { return std::to_string(v) + " "; });
+  }
+
+  template <typename Pred>
+  uint32_t count_where(Pred&& pred) const
+  {
+    return _plane.count_if(std::forward<Pred>(pred));
+  }
+
+ private:
+  void draw(Line const& line)
+  {
+    auto step = [](uint32_t from, uint32_t to) { return (from < to) - (from > to); };
+    auto idx = _plane.index(line.start.x, line.start.y);
+    auto offset =
+        _plane.offset(step(line.start.x, line.end.x), step(line.start.y, line.end.y));
+    for(uint32_t n = line.length(); n > 0; --n, idx += offset) ++_plane[idx];
+  }
+
+  uint32_t _width = 0;
+  uint32_t _height = 0;
+  std::vector<Line> _lines;
+  Grid<uint32_t> _plane;
+};
+
+inline std::vector<Line> parse_lines(std::string const& path = "./inputs/5-1.txt")
+{
+  InputView input(path);
+  std::vector<Line> lines;
+  for(auto line : input.lines())
+  {
+    Cursor cursor(line);
+    cursor >> lines.emplace_back();
+  }
+  return lines;
+}
+
+inline Plane parse_plane(std::string const& path = "./inputs/5-1.txt")
+{
+  return Plane(parse_lines(path));
+}
+
+namespace detail
+{
+// The four directions a vent line can run in. Every cell of a line shares the
+// line's key, key = cx * x + cy * y, and lines of two different families cross in
+// at most one cell.
+enum Family : uint8_t
+{
+  Horizontal,
+  Vertical,
+  Rising,   // x - y is constant
+  Falling,  // x + y is constant
+  NumFamilies
+};
+
+inline constexpr std::array<std::array<int64_t, 2>, NumFamilies> KeyCoefficients{
+    {{0, 1}, {1, 0}, {1, -1}, {1, 1}}};
+
+inline bool is_diagonal(Family family) { return family >= Rising; }
+
+inline Family family_of(Line const& line)
+{
+  int64_t dx = int64_t(line.end.x) - line.start.x;
+  int64_t dy = int64_t(line.end.y) - line.start.y;
+  if(dy == 0) return Horizontal;
+  if(dx == 0) return Vertical;
+  if(dx == dy) return Rising;
+  if(dx == -dy) return Falling;
+  throw std::out_of_range("Vent lines must be horizontal, vertical or at 45 degrees");
+}
+
+inline int64_t key_of(Family family, int64_t x, int64_t y)
+{
+  auto [cx, cy] = KeyCoefficients[family];
+  return cx * x + cy * y;
+}
+
+// Position of a cell along the lines of its family: y for vertical lines and x
+// for every other family, so consecutive cells of a line are one unit apart.
+inline int64_t along_of(Family family, int64_t x, int64_t y)
+{
+  return family == Vertical ? y : x;
+}
+
+inline std::pair<int64_t, int64_t> cell_at(Family family, int64_t key, int64_t along)
+{
+  switch(family)
+  {
+    case Horizontal:
+      return {along, key};
+    case Vertical:
+      return {key, along};
+    case Rising:
+      return {along, along - key};
+    default:
+      return {along, key - along};
+  }
+}
+
+// The cell where key f of family a meets key g of family b, if it is a lattice
+// point; the two diagonal families only meet on cells where f + g is even.
+inline std::optional<std::pair<int64_t, int64_t>> crossing(Family a, int64_t f, Family b,
+                                                           int64_t g)
+{
+  auto [ax, ay] = KeyCoefficients[a];
+  auto [bx, by] = KeyCoefficients[b];
+  auto det = ax * by - ay * bx;
+  auto x = f * by - ay * g;
+  auto y = ax * g - f * bx;
+  if(x % det != 0 || y % det != 0) return std::nullopt;
+  return std::pair{x / det, y / det};
+}
+
+// A maximal stretch of cells [Lo, Hi] along one key of a family.
+struct Run
+{
+  int64_t Key;
+  int64_t Lo;
+  int64_t Hi;
+};
+
+// Runs sorted by key and position: Covered holds the cells at least one line of the
+// family passes through, Shared the cells at least two do.
+struct FamilyRuns
+{
+  std::vector<Run> Covered;
+  std::vector<Run> Shared;
+};
+
+// Sweeps the start and end events of one family's lines key by key.
+inline FamilyRuns sweep_family(std::vector<std::tuple<int64_t, int64_t, int32_t>> events)
+{
+  std::sort(events.begin(), events.end());
+  FamilyRuns runs;
+  int64_t covered_from = 0;
+  int64_t shared_from = 0;
+  int32_t depth = 0;
+  for(size_t i = 0; i < events.size();)
+  {
+    auto [key, pos, _] = events[i];
+    auto before = depth;
+    for(; i < events.size() && std::get<0>(events[i]) == key &&
+          std::get<1>(events[i]) == pos;
+        ++i)
     {
-      for(auto row = 0; row < _width; ++row)
+      depth += std::get<2>(events[i]);
+    }
+    if(before < 1 && depth >= 1) covered_from = pos;
+    if(before >= 1 && depth < 1) runs.Covered.push_back({key, covered_from, pos - 1});
+    if(before < 2 && depth >= 2) shared_from = pos;
+    if(before >= 2 && depth < 2) runs.Shared.push_back({key, shared_from, pos - 1});
+  }
+  return runs;
+}
+
+inline bool contains(std::vector<Run> const& runs, int64_t key, int64_t along)
+{
+  auto it = std::upper_bound(runs.begin(), runs.end(), std::pair{key, along},
+                             [](auto const& value, Run const& run) {
+                               return value < std::pair{run.Key, run.Lo};
+                             });
+  if(it == runs.begin()) return false;
+  --it;
+  return it->Key == key && along <= it->Hi;
+}
+
+// Appends every cell where a covered run of family a crosses one of family b. In
+// (key a, key b) coordinates the runs of a are vertical segments and those of b
+// horizontal ones, so a sweep over key a with the open runs of b ordered by key b
+// reports each crossing once.
+inline void find_crossings(Family a, std::vector<Run> const& as, Family b,
+                           std::vector<Run> const& bs,
+                           std::vector<std::pair<int64_t, int64_t>>& cells)
+{
+  // Range of keys of the other family spanned by a run.
+  auto span_of = [](Family family, Run const& run, Family other) {
+    auto [lx, ly] = cell_at(family, run.Key, run.Lo);
+    auto [hx, hy] = cell_at(family, run.Key, run.Hi);
+    auto lo = key_of(other, lx, ly);
+    auto hi = key_of(other, hx, hy);
+    return std::pair{std::min(lo, hi), std::max(lo, hi)};
+  };
+
+  // Opening events sort before queries, and queries before closing events.
+  enum Kind : uint8_t
+  {
+    Open,
+    Query,
+    Close
+  };
+  // Events at a key of family a carry a range of keys of family b: a single key for
+  // the opening and closing of a run of b, the span of a run of a for a query.
+  std::vector<std::tuple<int64_t, Kind, int64_t, int64_t>> events;
+  events.reserve(as.size() + 2 * bs.size());
+  for(auto const& run : bs)
+  {
+    auto [lo, hi] = span_of(b, run, a);
+    events.emplace_back(lo, Open, run.Key, run.Key);
+    events.emplace_back(hi, Close, run.Key, run.Key);
+  }
+  for(auto const& run : as)
+  {
+    auto [lo, hi] = span_of(a, run, b);
+    events.emplace_back(run.Key, Query, lo, hi);
+  }
+  std::sort(events.begin(), events.end());
+
+  // Covered runs on one key are disjoint, so at most one run per key is open.
+  std::set<int64_t> open;
+  for(auto const& [key, kind, lo, hi] : events)
+  {
+    if(kind == Open) open.insert(lo);
+    else if(kind == Close) open.erase(lo);
+    else
+    {
+      for(auto it = open.lower_bound(lo); it != open.end() && *it <= hi; ++it)
       {
-        std::cout << _plane[col * _width + row] << " ";
+        if(auto cell = crossing(a, key, b, *it)) cells.push_back(*cell);
       }
-      std::cout << std::endl;
     }
   }
+}
+}  // namespace detail
+
+// Counts the cells covered by at least two lines without rasterizing the plane.
+// Collinear overlaps are found by sweeping each family's line events key by key;
+// lines of different families meet in single cells, which are enumerated by a
+// sweep per pair of families and deduplicated. Memory is proportional to the
+// number of lines plus the number of crossing cells, independent of the extent.
+inline uint64_t count_overlaps_sweep(std::span<Line const> lines, bool diagonals = true)
+{
+  using namespace detail;
+
+  std::array<std::vector<std::tuple<int64_t, int64_t, int32_t>>, NumFamilies> events;
+  for(auto const& line : lines)
+  {
+    auto family = family_of(line);
+    if(!diagonals && is_diagonal(family)) continue;
+    auto key = key_of(family, line.start.x, line.start.y);
+    auto from = along_of(family, line.start.x, line.start.y);
+    auto to = along_of(family, line.end.x, line.end.y);
+    events[family].emplace_back(key, std::min(from, to), 1);
+    events[family].emplace_back(key, std::max(from, to) + 1, -1);
+  }
+
+  int64_t total = 0;
+  std::array<FamilyRuns, NumFamilies> runs;
+  for(uint8_t f = 0; f < NumFamilies; ++f)
+  {
+    runs[f] = sweep_family(std::move(events[f]));
+    for(auto const& run : runs[f].Shared) total += run.Hi - run.Lo + 1;
+  }
 
-  uint32_t count_where(std::function<bool(uint32_t)> const& pred) const
+  std::vector<std::pair<int64_t, int64_t>> cells;
+  for(uint8_t a = 0; a < NumFamilies; ++a)
   {
-    uint32_t result = 0;
-    for(auto v : _plane)
+    for(uint8_t b = a + 1; b < NumFamilies; ++b)
     {
-      if(pred(v)) result++;
+      find_crossings(Family(a), runs[a].Covered, Family(b), runs[b].Covered, cells);
     }
+  }
+  std::sort(cells.begin(), cells.end());
+  cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
 
-    return result;
+  // A crossing cell is already counted once for every family whose lines overlap
+  // on it; it should be counted exactly once.
+  for(auto [x, y] : cells)
+  {
+    int64_t shared = 0;
+    for(uint8_t f = 0; f < NumFamilies; ++f)
+    {
+      auto family = Family(f);
+      shared += contains(runs[f].Shared, key_of(family, x, y), along_of(family, x, y));
+    }
+    total += shared == 0 ? 1 : 1 - shared;
   }
+  return total;
+}
 
- private:
-  uint32_t _width = 0;
-  uint32_t _height = 0;
-  std::vector<Line> _lines;
-  std::valarray<uint32_t> _plane;
+namespace detail
+{
+// 64 KiB of counters per tile, which stays resident in L2 while a tile is drawn.
+inline constexpr uint32_t TileSide = 256;
+
+// The part of a line that falls within one tile.
+struct TilePiece
+{
+  uint64_t Tile;
+  uint32_t X;
+  uint32_t Y;
+  uint32_t Length;
+  int8_t Dx;
+  int8_t Dy;
 };
 
-inline Plane parse_plane()
+// Splits every line at tile boundaries; the pieces come back grouped by tile.
+inline std::vector<TilePiece> bin_lines(std::span<Line const> lines, bool diagonals)
 {
-  auto input = open_input("./inputs/5-1.txt");
-  std::string line;
-  std::vector<Line> lines;
-  while(std::getline(input, line))
+  uint64_t tiles_x = 1;
+  for(auto const& line : lines)
+  {
+    auto x = std::max(line.start.x, line.end.x);
+    tiles_x = std::max<uint64_t>(tiles_x, x / TileSide + 1);
+  }
+
+  auto step = [](uint32_t from, uint32_t to) -> int8_t {
+    return (from < to) - (from > to);
+  };
+  // Cells left before a coordinate moving in direction d leaves its tile.
+  auto room = [](uint32_t v, int8_t d) -> uint32_t {
+    if(d == 0) return std::numeric_limits<uint32_t>::max();
+    return d > 0 ? TileSide - v % TileSide : v % TileSide + 1;
+  };
+
+  std::vector<TilePiece> pieces;
+  for(auto const& line : lines)
   {
-    std::istringstream iss(line);
-    iss >> lines.emplace_back();
+    if(!diagonals && is_diagonal(family_of(line))) continue;
+    auto dx = step(line.start.x, line.end.x);
+    auto dy = step(line.start.y, line.end.y);
+    auto x = line.start.x;
+    auto y = line.start.y;
+    for(uint32_t left = line.length(); left > 0;)
+    {
+      auto length = std::min({left, room(x, dx), room(y, dy)});
+      auto tile = uint64_t(y / TileSide) * tiles_x + x / TileSide;
+      pieces.push_back({tile, x, y, length, dx, dy});
+      x += dx * int64_t(length);
+      y += dy * int64_t(length);
+      left -= length;
+    }
+  }
+  std::sort(pieces.begin(), pieces.end(),
+            [](auto const& l, auto const& r) { return l.Tile < r.Tile; });
+  return pieces;
+}
+
+// Draws the pieces of one tile with counters that saturate at 2, then walks them
+// again to count the shared cells, clearing each as it goes so that it is counted
+// once and the buffer is zeroed for the next tile without touching untouched cells.
+inline uint64_t count_tile(std::span<TilePiece const> pieces, uint8_t* cells)
+{
+  auto walk = [&](auto&& visit) {
+    for(auto const& piece : pieces)
+    {
+      auto idx = (piece.Y % TileSide) * ptrdiff_t(TileSide) + piece.X % TileSide;
+      auto offset = piece.Dy * ptrdiff_t(TileSide) + piece.Dx;
+      for(uint32_t n = piece.Length; n > 0; --n, idx += offset) visit(cells[idx]);
+    }
+  };
+
+  walk([](uint8_t& c) { c += c < 2; });
+  uint64_t shared = 0;
+  walk([&](uint8_t& c) {
+    shared += c >= 2;
+    c = 0;
+  });
+  return shared;
+}
+}  // namespace detail
+
+// Counts the cells covered by at least two lines by rasterizing tile by tile.
+// Lines are clipped into cache-sized tiles and only tiles that some line touches
+// are drawn, in batches spread over the pool. Must not be called from one of the
+// pool's own workers, which would wait on tasks queued behind it.
+inline uint64_t count_overlaps_tiled(std::span<Line const> lines, ThreadPool& pool,
+                                     bool diagonals = true)
+{
+  using namespace detail;
+  auto pieces = bin_lines(lines, diagonals);
+
+  // Batches end on tile boundaries and hold roughly equal numbers of pieces.
+  auto batches = std::max<size_t>(pool.size() * 4, 1);
+  auto target = std::max<size_t>(pieces.size() / batches, 1);
+  std::vector<std::future<uint64_t>> counts;
+  for(size_t begin = 0; begin < pieces.size();)
+  {
+    auto end = std::min(begin + target, pieces.size());
+    while(end < pieces.size() && pieces[end].Tile == pieces[end - 1].Tile) ++end;
+    counts.push_back(pool.submit([&pieces, begin, end] {
+      std::vector<uint8_t> cells(TileSide * TileSide);
+      uint64_t shared = 0;
+      for(auto first = begin; first < end;)
+      {
+        auto last = first;
+        while(last < end && pieces[last].Tile == pieces[first].Tile) ++last;
+        shared += count_tile({pieces.data() + first, last - first}, cells.data());
+        first = last;
+      }
+      return shared;
+    }));
+    begin = end;
   }
 
-  return Plane(std::move(lines));
+  uint64_t total = 0;
+  for(auto& count : counts) total += count.get();
+  return total;
 }
 
+AOC_REGISTER_DAY(
+    5, "Hydrothermal Venture", "./inputs/5-1.txt",
+    [](std::string const& path) { return parse_lines(path); },
+    [](std::vector<Line>& lines) { return count_overlaps_sweep(lines, false); },
+    [](std::vector<Line>& lines) { return count_overlaps_sweep(lines); });
 }  // namespace aoc
@@ -2,24 +2,254 @@
 
 #include <algorithm>
 #include <cmath>
+#include <concepts>
 #include <cstdint>
 #include <limits>
-#include <map>
 #include <numeric>
+#include <span>
 #include <stdexcept>
-#include <valarray>
+#include <utility>
+#include <vector>
 
 #include "parse.h"
+#include "registry.h"
 #include "util.h"
 
 namespace aoc
 {
+// Fuel burnt by a whole army. A single crab's cost fits in 64 bits, but a thousand
+// crabs 2^30 positions out already burn more than 2^64 under triangular fuel.
+using FuelTotal = unsigned __int128;
+
+// Fuel models map the distance a crab moves to the fuel it burns; any convex one
+// works. Models that are polynomials of degree two or less also publish their
+// coefficients, cost(d) = (Linear * d + Quadratic * d^2) / Divisor, which lets
+// PositionSums total them over every crab without visiting each one. PositionSums
+// divides the summed polynomial once, which only equals the sum of the per-crab
+// costs when the division is exact at every distance, so that is required.
+template <typename Fuel>
+concept FuelModel = requires(Fuel const& fuel, uint64_t distance) {
+  { fuel(distance) } -> std::convertible_to<uint64_t>;
+};
+
+namespace detail
+{
+// Linear * d + Quadratic * d^2 taken mod Divisor repeats with period Divisor, so
+// checking one period covers every distance.
+template <typename Fuel>
+constexpr bool divides_exactly()
+{
+  if(Fuel::Divisor == 0) return false;
+  for(uint64_t d = 0; d < Fuel::Divisor; ++d)
+  {
+    if((Fuel::Linear * d + Fuel::Quadratic * d * d) % Fuel::Divisor != 0) return false;
+  }
+  return true;
+}
+}  // namespace detail
+
+template <typename Fuel>
+concept PolynomialFuel = FuelModel<Fuel> && requires {
+  { Fuel::Linear } -> std::convertible_to<uint64_t>;
+  { Fuel::Quadratic } -> std::convertible_to<uint64_t>;
+  { Fuel::Divisor } -> std::convertible_to<uint64_t>;
+} && detail::divides_exactly<Fuel>();
+
+// One unit of fuel per step.
+struct LinearFuel
+{
+  static constexpr uint64_t Linear = 1, Quadratic = 0, Divisor = 1;
+  constexpr uint64_t operator()(uint64_t distance) const { return distance; }
+};
+
+// One more unit for every step than for the one before: 1 + 2 + ... + d.
+struct TriangularFuel
+{
+  static constexpr uint64_t Linear = 1, Quadratic = 1, Divisor = 2;
+  constexpr uint64_t operator()(uint64_t distance) const
+  {
+    return distance * (distance + 1) / 2;
+  }
+};
+
+struct QuadraticFuel
+{
+  static constexpr uint64_t Linear = 0, Quadratic = 1, Divisor = 1;
+  constexpr uint64_t operator()(uint64_t distance) const { return distance * distance; }
+};
+
+// Running totals of the crab count, positions and squared positions over the
+// sorted distinct positions. Splitting the crabs at p into those at or left of it
+// and those right of it gives sum |p - x| and sum (p - x)^2 from the totals alone,
+// so a polynomial fuel model costs one binary search per position. The totals are
+// kept mod 2^128; the costs they are combined into are non-negative, so the
+// intermediate wrap-around cancels.
+class PositionSums
+{
+ public:
+  using Wide = unsigned __int128;
+
+  // Takes (position, count) pairs in increasing position order.
+  template <typename Histogram>
+  explicit PositionSums(Histogram const& histogram)
+  {
+    _positions.reserve(histogram.size());
+    _counts.reserve(histogram.size() + 1);
+    _sums.reserve(histogram.size() + 1);
+    _squares.reserve(histogram.size() + 1);
+    _counts.push_back(0);
+    _sums.push_back(0);
+    _squares.push_back(0);
+    for(auto const& [pos, num] : histogram)
+    {
+      _positions.push_back(pos);
+      _counts.push_back(_counts.back() + num);
+      _sums.push_back(_sums.back() + Wide(pos) * num);
+      _squares.push_back(_squares.back() + Wide(pos) * pos * num);
+    }
+  }
+
+  bool empty() const { return _positions.empty(); }
+  uint32_t min_position() const { return _positions.front(); }
+  uint32_t max_position() const { return _positions.back(); }
+  uint64_t floor_mean() const
+  {
+    return static_cast<uint64_t>(_sums.back() / _counts.back());
+  }
+
+  template <PolynomialFuel Fuel>
+  FuelTotal cost_at(uint32_t position, Fuel const& = {}) const
+  {
+    auto split = std::upper_bound(_positions.begin(), _positions.end(), position) -
+                 _positions.begin();
+    auto total = _positions.size();
+    Wide p = position;
+    Wide left = _counts[split], right = _counts[total] - left;
+    Wide left_sum = _sums[split], right_sum = _sums[total] - left_sum;
+    Wide left_squares = _squares[split], right_squares = _squares[total] - left_squares;
+
+    Wide distances = (left * p - left_sum) + (right_sum - right * p);
+    Wide squares = (left_squares - 2 * p * left_sum + left * p * p) +
+                   (right_squares - 2 * p * right_sum + right * p * p);
+    return (Fuel::Linear * distances + Fuel::Quadratic * squares) / Fuel::Divisor;
+  }
+
+ private:
+  std::vector<uint32_t> _positions;
+  std::vector<Wide> _counts;
+  std::vector<Wide> _sums;
+  std::vector<Wide> _squares;
+};
+
+// Minimum of a convex function over the integers in [lo, hi]. Bisects on the sign
+// of the forward difference f(m + 1) - f(m), which for a convex function changes
+// from negative to non-negative exactly once, at the minimum.
+template <typename F>
+auto minimize_convex(int64_t lo, int64_t hi, F&& f)
+{
+  while(lo < hi)
+  {
+    auto mid = lo + (hi - lo) / 2;
+    if(f(mid) <= f(mid + 1)) hi = mid;
+    else lo = mid + 1;
+  }
+  return f(lo);
+}
+
+// (position, count) pairs in increasing position order.
+using CrabHistogram = std::vector<std::pair<uint32_t, uint32_t>>;
+
+namespace detail
+{
+// Ranges at most this many times the crab count, or this wide outright, are
+// counted in a dense array; sparser inputs are radix sorted instead.
+inline constexpr uint64_t DenseRangePerCrab = 4;
+inline constexpr uint64_t DenseRangeMin = 1 << 16;
+
+inline CrabHistogram count_dense(std::span<uint32_t const> positions, uint32_t lo,
+                                 uint32_t hi)
+{
+  std::vector<uint32_t> counts(uint64_t(hi) - lo + 1);
+  for(auto pos : positions) ++counts[pos - lo];
+  CrabHistogram histogram;
+  for(size_t i = 0; i < counts.size(); ++i)
+  {
+    if(counts[i] > 0) histogram.emplace_back(uint32_t(lo + i), counts[i]);
+  }
+  return histogram;
+}
+
+// LSD radix sort over three 11-bit digits, skipping any digit every key shares.
+inline void radix_sort(std::vector<uint32_t>& keys)
+{
+  constexpr uint32_t DigitBits = 11;
+  constexpr uint32_t Buckets = 1 << DigitBits;
+  std::vector<uint32_t> scratch(keys.size());
+  for(uint32_t shift = 0; shift < 32; shift += DigitBits)
+  {
+    std::vector<uint32_t> offsets(Buckets + 1);
+    for(auto key : keys) ++offsets[((key >> shift) & (Buckets - 1)) + 1];
+    if(std::find(offsets.begin(), offsets.end(), keys.size()) != offsets.end()) continue;
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    for(auto key : keys) scratch[offsets[(key >> shift) & (Buckets - 1)]++] = key;
+    keys.swap(scratch);
+  }
+}
+
+inline CrabHistogram count_sorted(std::span<uint32_t const> positions)
+{
+  std::vector<uint32_t> sorted(positions.begin(), positions.end());
+  radix_sort(sorted);
+  CrabHistogram histogram;
+  for(auto pos : sorted)
+  {
+    if(histogram.empty() || histogram.back().first != pos) histogram.emplace_back(pos, 0);
+    ++histogram.back().second;
+  }
+  return histogram;
+}
+}  // namespace detail
+
+// Counting sort of the positions into a histogram, through a dense array when the
+// range is narrow enough and a radix sort otherwise.
+inline CrabHistogram count_positions(std::span<uint32_t const> positions)
+{
+  if(positions.empty()) return {};
+  auto [lo, hi] = std::minmax_element(positions.begin(), positions.end());
+  auto range = uint64_t(*hi) - *lo + 1;
+  auto dense_limit = std::max(detail::DenseRangeMin,
+                              detail::DenseRangePerCrab * positions.size());
+  if(range <= dense_limit)
+  {
+    return detail::count_dense(positions, *lo, *hi);
+  }
+  return detail::count_sorted(positions);
+}
+
 struct CrabArmy
 {
+  CrabArmy() = default;
+
+  explicit CrabArmy(std::span<uint32_t const> positions)
+      : _size(positions.size()), _soliders_by_position(count_positions(positions))
+  {
+    if(!_soliders_by_position.empty()) _max_position = _soliders_by_position.back().first;
+  }
+
+  // Inserts into the sorted histogram; prefer the constructor for bulk input.
   void add_solider(uint32_t position)
   {
     _max_position = std::max(position, _max_position);
-    _soliders_by_position[position]++;
+    auto it = std::lower_bound(_soliders_by_position.begin(), _soliders_by_position.end(),
+                               position, [](auto const& entry, uint32_t pos) {
+                                 return entry.first < pos;
+                               });
+    if(it == _soliders_by_position.end() || it->first != position)
+    {
+      it = _soliders_by_position.emplace(it, position, 0);
+    }
+    it->second++;
+    ++_size;
   }
 
   void print()
@@ -31,53 +261,111 @@ struct CrabArmy
     std::cout << std::endl;
   }
 
-  uint32_t min_alignment() const
+  size_t size() const { return _size; }
+
+  // Fuel spent by every crab moving to `position`.
+  template <FuelModel Fuel>
+  FuelTotal cost_at(uint32_t position, Fuel const& fuel = {}) const
   {
-    std::valarray<uint32_t> initial_positions(_max_position + 1),
-        cost_vector(_max_position + 1);
+    FuelTotal cost = 0;
     for(auto const& [pos, num] : _soliders_by_position)
     {
-      initial_positions[pos] = num;
+      cost += FuelTotal(num) * static_cast<uint64_t>(fuel(abs_diff(pos, position)));
+    }
+    return cost;
+  }
+
+  // Linear cost is minimised at the median. The triangular cost's derivative at p
+  // is n * (p - mean) plus a term bounded by n / 2, so its real minimum lies within
+  // half a position of the mean and the integer one among the four positions from
+  // floor(mean) - 1 to floor(mean) + 2. Any other convex model is searched, through
+  // prefix sums when it is a polynomial and crab by crab otherwise.
+  template <FuelModel Fuel>
+  FuelTotal min_alignment(Fuel const& fuel = {}) const
+  {
+    if(_size == 0) throw std::out_of_range("No crabs to align");
+    auto lo = _soliders_by_position.begin()->first;
+    if constexpr(std::same_as<Fuel, LinearFuel>)
+    {
+      return cost_at(median(), fuel);
     }
-    for(auto i = 1; i < _max_position + 1; ++i)
+    else if constexpr(std::same_as<Fuel, TriangularFuel>)
     {
-      cost_vector[i] = i + cost_vector[i - 1];
+      PositionSums sums(_soliders_by_position);
+      int64_t mean = sums.floor_mean();
+      auto cost = ~FuelTotal{0};
+      for(auto p = std::max<int64_t>(mean - 1, lo);
+          p <= std::min<int64_t>(mean + 2, _max_position); ++p)
+      {
+        cost = std::min(cost, sums.cost_at(p, fuel));
+      }
+      return cost;
     }
-    uint32_t cost = std::numeric_limits<uint32_t>::max();
-    for(uint32_t aligned_pos = 0; aligned_pos < _max_position + 1; ++aligned_pos)
+    else
     {
-      uint32_t next_cost = (initial_positions * cost_vector).sum();
-      if(next_cost > cost) break;
-      cost_vector = cost_vector.cshift(-1);
-      cost_vector[0] = aligned_pos + 1 + cost_vector[1];
-      cost = next_cost;
+      return min_alignment_search(fuel);
     }
+  }
 
+  // Bisects for the minimum of any convex fuel model.
+  template <FuelModel Fuel>
+  FuelTotal min_alignment_search(Fuel const& fuel = {}) const
+  {
+    if(_size == 0) throw std::out_of_range("No crabs to align");
+    auto lo = _soliders_by_position.begin()->first;
+    if constexpr(PolynomialFuel<Fuel>)
+    {
+      PositionSums sums(_soliders_by_position);
+      return minimize_convex(lo, _max_position,
+                             [&](int64_t p) { return sums.cost_at(p, fuel); });
+    }
+    else
+    {
+      return minimize_convex(lo, _max_position,
+                             [&](int64_t p) { return cost_at(p, fuel); });
+    }
+  }
+
+  // Tries every position between the outermost crabs; for verifying min_alignment.
+  template <FuelModel Fuel>
+  FuelTotal min_alignment_exhaustive(Fuel const& fuel = {}) const
+  {
+    if(_size == 0) throw std::out_of_range("No crabs to align");
+    auto cost = ~FuelTotal{0};
+    for(auto p = _soliders_by_position.begin()->first; p <= _max_position; ++p)
+    {
+      cost = std::min(cost, cost_at(p, fuel));
+    }
     return cost;
   }
 
  private:
-  uint32_t _max_position = 0;
-  std::map<uint32_t, uint32_t> _soliders_by_position;
-};
-
-inline CrabArmy parse_crabs()
-{
-  auto input = open_input("./inputs/7-1.txt");
-  std::string line;
-  CrabArmy army;
-  while(std::getline(input, line))
+  // The lower median, found by walking the sorted histogram.
+  uint32_t median() const
   {
-    std::istringstream iss(line);
-    while(!iss.eof())
+    size_t seen = 0;
+    for(auto const& [pos, num] : _soliders_by_position)
     {
-      uint32_t pos;
-      iss >> pos;
-      army.add_solider(pos);
-      iss.ignore(1, ',');
+      seen += num;
+      if(2 * seen >= _size) return pos;
     }
+    return _max_position;
   }
 
-  return army;
+  uint32_t _max_position = 0;
+  size_t _size = 0;
+  CrabHistogram _soliders_by_position;
+};
+
+inline CrabArmy parse_crabs(std::string const& path = "./inputs/7-1.txt")
+{
+  InputView input(path);
+  return CrabArmy(parse_uints(input.contents()));
 }
+
+AOC_REGISTER_DAY(
+    7, "The Treachery of Whales", "./inputs/7-1.txt",
+    [](std::string const& path) { return parse_crabs(path); },
+    [](CrabArmy& army) { return to_string(army.min_alignment(LinearFuel{})); },
+    [](CrabArmy& army) { return to_string(army.min_alignment(TriangularFuel{})); });
 }  // namespace aoc
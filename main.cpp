@@ -1,44 +1,364 @@
-#include <chrono>
+#include <array>
+#include <cstdlib>
+#include <future>
+#include <iomanip>
 #include <iostream>
+#include <map>
+#include <optional>
 #include <ostream>
-#include <span>
+#include <stdexcept>
 #include <string>
-#include <tuple>
-#include <unordered_map>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
 
-#include "include/alu.h"
-#include "include/alu_input.h"
-#include "include/reactor.h"
-#include "include/sea_cucumbers.h"
-#include "include/util.h"
+#include "include/alloc_tracking.h"
+#include "include/registry.h"
+#include "include/thread_pool.h"
+#include "include/timing.h"
 
 using namespace std::literals::string_view_literals;
 
-int main(int argc, char** argv)
+namespace
+{
+struct Options
+{
+  std::optional<uint32_t> Day;
+  std::optional<size_t> Part;
+  std::optional<std::string> Input;
+  size_t Repeat = 1;
+  size_t Threads = std::thread::hardware_concurrency();
+  bool List = false;
+  bool All = false;
+};
+
+void usage(std::ostream& os)
+{
+  os << "usage: main --day N [--part P] [--input PATH] [--repeat K]\n"
+     << "       main --all [--threads T] [--repeat K]\n"
+     << "       main --list" << std::endl;
+}
+
+Options parse_options(int argc, char** argv)
+{
+  Options opts;
+  for(int i = 1; i < argc; ++i)
+  {
+    std::string_view arg = argv[i];
+    auto value = [&]() -> std::string {
+      if(i + 1 >= argc) throw std::invalid_argument("Missing value for option");
+      return argv[++i];
+    };
+    if(arg == "--day"sv)
+      opts.Day = std::stoul(value());
+    else if(arg == "--part"sv)
+      opts.Part = std::stoul(value());
+    else if(arg == "--input"sv)
+      opts.Input = value();
+    else if(arg == "--repeat"sv)
+      opts.Repeat = std::stoul(value());
+    else if(arg == "--threads"sv)
+      opts.Threads = std::stoul(value());
+    else if(arg == "--list"sv)
+      opts.List = true;
+    else if(arg == "--all"sv)
+      opts.All = true;
+    else
+      throw std::invalid_argument("Unknown option");
+  }
+  if(opts.Repeat == 0) throw std::invalid_argument("--repeat must be positive");
+  return opts;
+}
+
+void print_summary(std::string_view phase, aoc::Summary const& s)
 {
-  auto f = aoc::parse_fast_cucumbers();
-  auto t1 = std::chrono::high_resolution_clock::now();
-  auto result = f.move();
-  auto t2 = std::chrono::high_resolution_clock::now();
-  auto duration = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1);
-  std::cout << "Result: " << result << " in " << duration.count() << " microseconds "
+  std::cout << "  " << std::left << std::setw(6) << phase << std::right << std::fixed
+            << std::setprecision(1) << " min " << std::setw(12) << aoc::to_micros(s.Min)
+            << " us  median " << std::setw(12) << aoc::to_micros(s.Median)
+            << " us  p99 " << std::setw(12) << aoc::to_micros(s.P99) << " us"
             << std::endl;
+}
+
+void print_allocs(std::string_view phase, aoc::alloc::Counters const& c)
+{
+  std::cout << "  " << std::left << std::setw(6) << phase << std::right << " allocs "
+            << std::setw(10) << c.Allocations << "  bytes " << std::setw(12) << c.Bytes
+            << std::endl;
+}
+
+// Allocation counts and bytes for a timed phase; zero unless tracking is built in.
+// Only the calling thread is counted unless all_threads is set, which is exact only
+// while nothing else runs.
+template <typename F>
+aoc::Duration time_phase(aoc::alloc::Counters& allocs, F&& f, bool all_threads = false)
+{
+  return aoc::time_it([&] {
+    allocs = all_threads ? aoc::alloc::measure_process(f) : aoc::alloc::measure(f);
+  });
+}
+
+// Each repetition parses afresh, since most solvers consume or mutate their state.
+// Nothing else runs meanwhile, so allocations count every thread the solver uses.
+void run_part(aoc::Day const& day, size_t part, std::string const& input, size_t repeat)
+{
+  std::vector<aoc::Duration> parse_times, solve_times;
+  std::string answer;
+  aoc::alloc::Counters parse_allocs, solve_allocs;
+  for(size_t n = 0; n < repeat; ++n)
+  {
+    aoc::Day::Parsed parsed;
+    parse_times.push_back(
+        time_phase(parse_allocs, [&] { parsed = day.Parse(input); }, true));
+    solve_times.push_back(
+        time_phase(solve_allocs, [&] { answer = day.Solve(part, parsed); }, true));
+  }
+
+  std::cout << "Day " << day.Number << " part " << part << ": " << answer << std::endl;
+  print_summary("parse", aoc::summarize(parse_times));
+  print_summary("solve", aoc::summarize(solve_times));
+  if constexpr(aoc::alloc::Enabled)
+  {
+    print_allocs("parse", parse_allocs);
+    print_allocs("solve", solve_allocs);
+  }
+}
+
+struct PartRun
+{
+  std::string Answer;
+  aoc::Duration Solve{};
+  aoc::alloc::Counters Allocs;
+  aoc::Clock::time_point Finished;
+};
+
+struct DayRun
+{
+  aoc::Clock::time_point Started;
+  aoc::Duration Parse{};
+  aoc::alloc::Counters ParseAllocs;
+  std::array<std::future<PartRun>, 2> Parts;
+};
+
+// Parses once and solves part 1 in place. Part 2 goes back to the pool on its own
+// copy of the parsed state, since solvers are free to mutate what they are given.
+DayRun run_day(aoc::ThreadPool& pool, aoc::Day const& day)
+{
+  DayRun run;
+  run.Started = aoc::Clock::now();
+  aoc::Day::Parsed parsed;
+  run.Parse = time_phase(run.ParseAllocs, [&] { parsed = day.Parse(day.Input); });
+
+  auto solve = [&day](size_t part, aoc::Day::Parsed const& state) {
+    PartRun result;
+    result.Solve =
+        time_phase(result.Allocs, [&] { result.Answer = day.Solve(part, state); });
+    result.Finished = aoc::Clock::now();
+    return result;
+  };
+
+  if(day.HasPart(2))
+  {
+    // Copied before part 1 starts mutating the original.
+    auto state = day.Copy ? day.Copy(parsed) : day.Parse(day.Input);
+    run.Parts[1] = pool.submit([state, solve]() { return solve(2, state); });
+  }
+  if(day.HasPart(1))
+  {
+    std::promise<PartRun> part1;
+    try
+    {
+      part1.set_value(solve(1, parsed));
+    }
+    catch(...)
+    {
+      part1.set_exception(std::current_exception());
+    }
+    run.Parts[0] = part1.get_future();
+  }
+  return run;
+}
+
+struct DayStats
+{
+  std::vector<aoc::Duration> Parse, Latency;
+  std::array<std::vector<aoc::Duration>, 2> Solve;
+  std::array<std::string, 2> Answers;
+  // Parse, part 1 and part 2 of the last repetition.
+  std::array<aoc::alloc::Counters, 3> Allocs;
+  std::string Error;
+};
+
+// Every registered day is scheduled at once; a day's latency runs from the start
+// of its parse until its last part finishes.
+int run_all(size_t threads, size_t repeat)
+{
+  auto const& days = aoc::registry();
+  std::map<uint32_t, DayStats> stats;
+  std::vector<aoc::Duration> batch_times;
+  aoc::ThreadPool pool(threads);
+
+  for(size_t n = 0; n < repeat; ++n)
+  {
+    std::vector<std::pair<uint32_t, std::future<DayRun>>> runs;
+    auto batch = aoc::time_it([&] {
+      for(auto const& [number, day] : days)
+      {
+        runs.emplace_back(number, pool.submit([&pool, &day = day] {
+                            return run_day(pool, day);
+                          }));
+      }
+      for(auto& [number, future] : runs)
+      {
+        auto& s = stats[number];
+        try
+        {
+          auto run = future.get();
+          auto finished = run.Started + run.Parse;
+          for(size_t part = 0; part < 2; ++part)
+          {
+            if(!run.Parts[part].valid()) continue;
+            auto result = run.Parts[part].get();
+            s.Answers[part] = std::move(result.Answer);
+            s.Allocs[part + 1] = result.Allocs;
+            s.Solve[part].push_back(result.Solve);
+            finished = std::max(finished, result.Finished);
+          }
+          s.Parse.push_back(run.Parse);
+          s.Allocs[0] = run.ParseAllocs;
+          s.Latency.push_back(
+              std::chrono::duration_cast<aoc::Duration>(finished - run.Started));
+        }
+        catch(std::exception const& e)
+        {
+          s.Error = e.what();
+        }
+      }
+    });
+    batch_times.push_back(batch);
+  }
+
+  auto median = [](std::vector<aoc::Duration> const& samples) {
+    return aoc::to_micros(aoc::summarize(samples).Median);
+  };
+  int status = EXIT_SUCCESS;
+  aoc::Duration serial{};
+  std::cout << "Day   parse us  part 1 us  part 2 us latency us  answers (medians of "
+            << repeat << " runs on " << pool.size() << " threads)" << std::endl;
+  for(auto const& [number, s] : stats)
+  {
+    std::cout << std::setw(3) << number << ' ';
+    if(!s.Error.empty())
+    {
+      std::cout << "failed: " << s.Error << std::endl;
+      status = EXIT_FAILURE;
+      continue;
+    }
+    std::cout << std::fixed << std::setprecision(1) << std::setw(10) << median(s.Parse);
+    for(auto const& solve : s.Solve)
+    {
+      std::cout << ' ' << std::setw(10);
+      if(solve.empty())
+        std::cout << '-';
+      else
+        std::cout << median(solve);
+    }
+    std::cout << ' ' << std::setw(10) << median(s.Latency) << "  "
+              << (s.Answers[0].empty() ? "-" : s.Answers[0]) << " / "
+              << (s.Answers[1].empty() ? "-" : s.Answers[1]) << std::endl;
+    serial += aoc::summarize(s.Latency).Median;
+  }
+  print_summary("batch", aoc::summarize(batch_times));
+  std::cout << "  sum of day latencies " << std::fixed << std::setprecision(1)
+            << aoc::to_micros(serial) << " us" << std::endl;
+
+  if constexpr(aoc::alloc::Enabled)
+  {
+    std::cout << std::endl
+              << "Allocations on each phase's own thread; threads a solver starts "
+              << "are not counted" << std::endl
+              << "Day  parse allocs       bytes  part 1 allocs       bytes"
+              << "  part 2 allocs       bytes" << std::endl;
+    for(auto const& [number, s] : stats)
+    {
+      if(!s.Error.empty()) continue;
+      std::cout << std::setw(3) << number;
+      for(size_t phase = 0; phase < 3; ++phase)
+      {
+        auto const& c = s.Allocs[phase];
+        bool ran = phase == 0 || !s.Solve[phase - 1].empty();
+        std::cout << std::setw(phase == 0 ? 14 : 15);
+        if(ran)
+          std::cout << c.Allocations << std::setw(12) << c.Bytes;
+        else
+          std::cout << '-' << std::setw(12) << '-';
+      }
+      std::cout << std::endl;
+    }
+  }
+  return status;
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  Options opts;
+  try
+  {
+    opts = parse_options(argc, argv);
+  }
+  catch(std::exception const& e)
+  {
+    std::cerr << e.what() << std::endl;
+    usage(std::cerr);
+    return EXIT_FAILURE;
+  }
+
+  auto const& days = aoc::registry();
+  if(opts.All) return run_all(opts.Threads, opts.Repeat);
+  if(opts.List)
+  {
+    for(auto const& [number, day] : days)
+    {
+      std::cout << std::setw(2) << number << "  " << day.Name << " ["
+                << (day.HasPart(1) ? "1" : "-") << (day.HasPart(2) ? "2" : "-") << "]"
+                << std::endl;
+    }
+    return EXIT_SUCCESS;
+  }
+
+  if(!opts.Day)
+  {
+    usage(std::cerr);
+    return EXIT_FAILURE;
+  }
+
+  auto it = days.find(*opts.Day);
+  if(it == days.end())
+  {
+    std::cerr << "Day " << *opts.Day << " is not registered" << std::endl;
+    return EXIT_FAILURE;
+  }
 
-  // using TupleType = std::tuple<size_t, std::string, char>;
-  // std::unordered_map<TupleType, size_t, aoc::tuple_hash> example;
-  // example[{1, "two", '3'}] = 4;
-  // example[{0, "one", '2'}] = 0;
-  // example[{2, "three", '4'}] = 5;
-
-  // for(auto const& [tup, val] : example)
-  // {
-  //   std::cout << "[" << std::get<0>(tup) << ", " << std::get<1>(tup) << ", "
-  //             << std::get<2>(tup) << "]: " << val << std::endl;
-  // }
-  // example[{0, "one", '2'}] += 3;
-  // for(auto const& [tup, val] : example)
-  // {
-  //   std::cout << "[" << std::get<0>(tup) << ", " << std::get<1>(tup) << ", "
-  //             << std::get<2>(tup) << "]: " << val << std::endl;
-  // }
+  auto const& day = it->second;
+  auto input = opts.Input.value_or(day.Input);
+  for(size_t part = 1; part <= 2; ++part)
+  {
+    if(opts.Part && *opts.Part != part) continue;
+    if(!day.HasPart(part))
+    {
+      if(opts.Part) std::cerr << "Part " << part << " is not implemented" << std::endl;
+      continue;
+    }
+    try
+    {
+      run_part(day, part, input, opts.Repeat);
+    }
+    catch(std::exception const& e)
+    {
+      std::cerr << "Day " << *opts.Day << " part " << part << " failed: " << e.what()
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
 }